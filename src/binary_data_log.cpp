@@ -2,6 +2,8 @@
 #include "slam_log_reporter.h"
 #include "slam_operations.h"
 
+#include "cstring"
+
 namespace slam_data_log {
 
 namespace {
@@ -9,39 +11,35 @@ namespace {
 }
 
 BinaryDataLog::~BinaryDataLog() {
-    if (file_w_ptr_ != nullptr) {
-        file_w_ptr_->close();
-    }
-    if (file_r_ptr_ != nullptr) {
-        file_r_ptr_->close();
-    }
+    StopPrefetching();
+    CloseLogFile();
+    mapped_file_r_.Close();
 }
 
 void BinaryDataLog::CleanUp() {
+    StopPrefetching();
+
     // Support for decodec.
     packages_id_with_objects_.clear();
 
     // Support for recorder.
-    if (file_w_ptr_ != nullptr) {
-        file_w_ptr_->close();
-    }
-    file_w_ptr_ = nullptr;
+    CloseLogFile();
     start_system_time_ = std::chrono::system_clock::now();
 
     // Support for decoder.
     packages_id_with_data_.clear();
+    packages_id_with_columns_.clear();
+    payload_cache_.Clear();
+    packages_id_with_item_pyramids_.clear();
 }
 
 bool BinaryDataLog::IsDynamicType(uint8_t type_code) { return type_code > static_cast<uint8_t>(ItemType::kPose6Dof); }
 
 bool BinaryDataLog::IsDynamicType(ItemType type) { return type > ItemType::kPose6Dof; }
 
-bool BinaryDataLog::CreateLogFile(const std::string &log_file_name) {
+bool BinaryDataLog::CreateLogFile(const std::string &log_file_name, const FrameCheckType frame_check_type) {
     // If last log file is not closed, close it.
-    if (file_w_ptr_ != nullptr) {
-        file_w_ptr_->close();
-        file_w_ptr_.reset();
-    }
+    CloseLogFile();
 
     // Try to create new log file.
     file_w_ptr_ = std::make_unique<std::fstream>(log_file_name, std::ios::out | std::ios::binary);
@@ -51,6 +49,8 @@ bool BinaryDataLog::CreateLogFile(const std::string &log_file_name) {
     }
 
     // Write log header.
+    committed_size_in_file_ = 0;
+    frame_check_type_ = frame_check_type;
     WriteLogFileHeader();
 
     return true;
@@ -79,6 +79,12 @@ bool BinaryDataLog::RegisterPackage(std::unique_ptr<PackageInfo> &new_package) {
         }
     }
 
+    // Package id of footer index is reserved.
+    if (new_package->id == kFooterIndexPackageId) {
+        ReportError("[DataLog] Package id " << kFooterIndexPackageId << " is reserved for footer index.");
+        return false;
+    }
+
     // Do not repeat registering the same package.
     if (packages_id_with_objects_.find(new_package->id) != packages_id_with_objects_.end()) {
         ReportError("[DataLog] Package to be registered is exist now.");
@@ -100,28 +106,128 @@ bool BinaryDataLog::RegisterPackage(std::unique_ptr<PackageInfo> &new_package) {
 
 bool BinaryDataLog::PrepareForRecording() {
     RETURN_FALSE_IF_FALSE(RecordAllRegisteredPackagesAsFileHead());
+    is_file_head_recorded_ = true;
     return true;
 }
 
-void BinaryDataLog::WriteLogFileHeader() { file_w_ptr_->write(binary_log_file_header.c_str(), binary_log_file_header.size()); }
+bool BinaryDataLog::CloseLogFile() {
+    RETURN_FALSE_IF(file_w_ptr_ == nullptr);
+
+    // Drain asynchronous recorder, then append footer index after all frames.
+    StopAsyncRecording();
+    bool result = true;
+    if (record_footer_index_ && is_file_head_recorded_) {
+        result = RecordFooterIndex();
+    }
+
+    file_w_ptr_->close();
+    file_w_ptr_.reset();
+    is_file_head_recorded_ = false;
+    packages_id_with_index_.clear();
+    return result;
+}
+
+BinaryDataLog::StagingBuffer &BinaryDataLog::StagingBufferOfThisThread() {
+    // Each recording thread serializes its bytes here, so recorders never contend with each other until commit.
+    static thread_local StagingBuffer staging_buffer;
+    return staging_buffer;
+}
+
+char *BinaryDataLog::AllocateBytesInStagingBuffer(const uint32_t size) {
+    StagingBuffer &staging_buffer = StagingBufferOfThisThread();
+    if (staging_buffer.bytes.size() < staging_buffer.size + size) {
+        staging_buffer.bytes.resize(staging_buffer.size + size);
+    }
+    char *data_ptr = staging_buffer.bytes.data() + staging_buffer.size;
+    staging_buffer.size += size;
+    return data_ptr;
+}
+
+void BinaryDataLog::WriteBytesToLogFile(const char *data_ptr, const uint32_t size) {
+    std::memcpy(AllocateBytesInStagingBuffer(size), data_ptr, size);
+}
+
+void BinaryDataLog::CommitStagedBytesToLogFile(const bool record_in_index) {
+    StagingBuffer &staging_buffer = StagingBufferOfThisThread();
+    if (file_w_ptr_ == nullptr) {
+        staging_buffer.size = 0;
+        return;
+    }
 
-uint8_t BinaryDataLog::SummaryBytes(const uint8_t *byte_ptr, const uint32_t size, const uint8_t init_value) {
-    uint8_t value = init_value;
-    for (uint32_t i = 0; i < size; ++i) {
-        value += byte_ptr[i];
+    if (IsAsyncRecording()) {
+        CommitBytesToAsyncRingBuffer(staging_buffer.bytes.data(), staging_buffer.size, record_in_index);
+    } else {
+        std::unique_lock<std::mutex> lock(file_w_mutex_);
+        if (record_in_index) {
+            RecordFrameInIndex(committed_size_in_file_, staging_buffer.bytes.data(), staging_buffer.size);
+        }
+        file_w_ptr_->write(staging_buffer.bytes.data(), staging_buffer.size);
+        committed_size_in_file_ += staging_buffer.size;
     }
-    return value;
+    staging_buffer.size = 0;
+}
+
+void BinaryDataLog::RecordFrameInIndex(const uint64_t index_in_file, const char *frame_ptr, const uint32_t size) {
+    RETURN_IF(!record_footer_index_);
+    uint16_t package_id = 0;
+    PackageIndexPerTick index_per_tick;
+    std::memcpy(&package_id, frame_ptr + 4, 2);
+    std::memcpy(&index_per_tick.timestamp_s, frame_ptr + 6, 4);
+    index_per_tick.index_in_file = index_in_file;
+    index_per_tick.size_of_all_in_file = size;
+    packages_id_with_index_[package_id].emplace_back(index_per_tick);
 }
 
-std::string BinaryDataLog::LoadStringFromBinaryFile(uint32_t size) {
-    char *buffer = new char[size + 1];
-    file_r_ptr_->read(buffer, size);
-    buffer[size] = '\0';
+char *BinaryDataLog::BeginFrameInStagingBuffer(const uint16_t package_id, const float time_stamp_s, const uint32_t data_size) {
+    // offset, package_id, timestamp, binary_data, check_bytes.
+    const uint32_t offset = 4 + 2 + 4 + data_size + FrameCheckSize();
+    char *frame_ptr = AllocateBytesInStagingBuffer(offset);
+    std::memcpy(frame_ptr, &offset, 4);
+    std::memcpy(frame_ptr + 4, &package_id, 2);
+    std::memcpy(frame_ptr + 6, &time_stamp_s, 4);
+    return frame_ptr + 10;
+}
+
+void BinaryDataLog::EndFrameInStagingBuffer(const bool record_in_index) {
+    // Each frame is committed alone, so it starts at the beginning of staging buffer.
+    SealFrameInStagingBuffer(0);
+    CommitStagedBytesToLogFile(record_in_index);
+}
 
-    std::string str(buffer);
-    delete[] buffer;
+void BinaryDataLog::SealFrameInStagingBuffer(const uint32_t index_of_frame_in_staging_buffer) const {
+    // The frame is the last one in staging buffer. Check bytes cover all bytes of this frame except themselves.
+    StagingBuffer &staging_buffer = StagingBufferOfThisThread();
+    uint8_t *frame_ptr = reinterpret_cast<uint8_t *>(staging_buffer.bytes.data()) + index_of_frame_in_staging_buffer;
+    const uint32_t check_size = FrameCheckSize();
+    const uint32_t size_except_check = staging_buffer.size - index_of_frame_in_staging_buffer - check_size;
+    const uint32_t check_value = UpdateFrameCheckValue(frame_ptr, size_except_check, 0);
+    std::memcpy(frame_ptr + size_except_check, &check_value, check_size);
+}
+
+void BinaryDataLog::CommitStagedFramesToLogFile() {
+    // All frames staged by this thread are written at once, but each of them is recorded in index. Only used without asynchronous recorder.
+    StagingBuffer &staging_buffer = StagingBufferOfThisThread();
+    if (file_w_ptr_ == nullptr) {
+        staging_buffer.size = 0;
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(file_w_mutex_);
+    for (uint32_t index = 0; index < staging_buffer.size;) {
+        uint32_t size_of_frame = 0;
+        std::memcpy(&size_of_frame, staging_buffer.bytes.data() + index, 4);
+        RecordFrameInIndex(committed_size_in_file_ + index, staging_buffer.bytes.data() + index, size_of_frame);
+        index += size_of_frame;
+    }
+    file_w_ptr_->write(staging_buffer.bytes.data(), staging_buffer.size);
+    committed_size_in_file_ += staging_buffer.size;
+    staging_buffer.size = 0;
+}
 
-    return str;
+void BinaryDataLog::WriteLogFileHeader() {
+    const std::string &header = frame_check_type_ == FrameCheckType::kCrc32c ? binary_log_file_header_with_crc32c : binary_log_file_header;
+    WriteBytesToLogFile(header.c_str(), header.size());
+    CommitStagedBytesToLogFile();
 }
 
 void BinaryDataLog::ReportAllRegisteredPackages() {
@@ -208,6 +314,29 @@ void BinaryDataLog::ReportAllLoadedPackages() {
             ReportText(std::endl);
         }
     }
+
+    for (const auto &[package_id, columns]: packages_id_with_columns_) {
+        ReportColorInfo(">> Package id : " << package_id << ", stored in columns, context [ time(ms) | index_in_log_file | size_of_all_in_file | bindata ] :");
+        for (uint32_t i = 0; i < columns.size(); ++i) {
+            ReportText(GREEN "[Info ] " RESET_COLOR "      " << columns.timestamps_s[i] << " | ");
+            ReportText(columns.indices_in_file[i] << " | ");
+            ReportText(columns.size_of_all_in_file << " | ");
+
+            // Print loaded bytes of this item.
+            if (columns.size_of_data != 0) {
+                ReportText("[Bytes] ");
+                const uint8_t *data_ptr = columns.data_of_tick(i);
+                const uint32_t max_j = std::min(kMaxPrintBytesForEachItem, columns.size_of_data);
+                for (uint32_t j = 0; j < max_j; ++j) {
+                    ReportText(static_cast<int32_t>(data_ptr[j]) << " ");
+                }
+                if (kMaxPrintBytesForEachItem < columns.size_of_data) {
+                    ReportText("... (" << columns.size_of_data << " bytes)");
+                }
+            }
+            ReportText(std::endl);
+        }
+    }
 }
 
 }  // namespace slam_data_log
@@ -3,15 +3,24 @@
 
 #include "binary_data_log_basic_type.h"
 #include "binary_data_log_file_protocal.h"
+#include "binary_data_log_item_pyramid.h"
+#include "binary_data_log_mapped_file.h"
+#include "binary_data_log_payload_cache.h"
 #include "datatype_image.h"
 
+#include "atomic"
 #include "chrono"
+#include "condition_variable"
+#include "functional"
 #include "fstream"
 #include "iostream"
 #include "memory"
+#include "mutex"
+#include "thread"
 
 #include "string"
 #include "unordered_map"
+#include "unordered_set"
 #include "vector"
 
 namespace slam_data_log {
@@ -19,6 +28,14 @@ namespace slam_data_log {
 /* Class BinaryDataLog Declaration. */
 class BinaryDataLog {
 
+public:
+    static constexpr uint32_t kDefaultAsyncRingBufferSize = 16 * 1024 * 1024;
+    // Return false to stop visiting.
+    using PackageVisitor = std::function<bool(const PackageDataView &)>;
+    // New ticks of package are [index_of_first_new_tick, end) in loaded package. If timestamps of new ticks are not later than loaded ones,
+    // some loaded ticks are also moved after index_of_first_new_tick.
+    using NewTicksSubscriber = std::function<void(const uint16_t package_id, const uint32_t index_of_first_new_tick, const uint32_t num_of_new_ticks)>;
+
 public:
     BinaryDataLog() = default;
     virtual ~BinaryDataLog();
@@ -28,9 +45,10 @@ public:
     static bool IsDynamicType(ItemType type);
 
     // Support for recorder.
-    bool CreateLogFile(const std::string &log_file_name = "data.binlog");
+    bool CreateLogFile(const std::string &log_file_name = "data.binlog", const FrameCheckType frame_check_type = FrameCheckType::kSummaryByte);
     bool RegisterPackage(std::unique_ptr<PackageInfo> &new_package);
     bool PrepareForRecording();
+    bool CloseLogFile();
     bool RecordPackage(const uint16_t package_id, const char *data_ptr);
     bool RecordPackage(const uint16_t package_id, const char *data_ptr, const float time_stamp_s);
     bool RecordPackage(const uint16_t package_id, const GrayImage &image);
@@ -48,16 +66,95 @@ public:
     bool RecordPackage(const uint16_t package_id, const std::vector<std::pair<Vec3, Vec3>> &line_cloud);
     bool RecordPackage(const uint16_t package_id, const std::vector<std::pair<Vec3, Vec3>> &line_cloud, const float time_stamp_s);
 
-    // Support for decoder.
+    // Support for asynchronous recorder. RecordPackage can be called by multiple threads at the same time,
+    // as long as no package is registered after PrepareForRecording.
+    bool EnableAsyncRecording(const uint32_t ring_buffer_size = kDefaultAsyncRingBufferSize);
+    bool FlushAsyncRecording();
+    void StopAsyncRecording();
+    bool IsAsyncRecording() const { return async_writer_thread_.joinable(); }
+
+    // Support for decoder. Index of frames is saved into sidecar index file after scanning, and reused by reopening if it is still valid.
     bool LoadLogFile(const std::string &log_file_name, bool load_dynamic_package_full_data = false);
+    bool LoadLogFileIndex(const std::string &log_file_name);
     template <typename T>
     static T ConvertBytes(const uint8_t *bytes, ItemType type);
     template <typename T>
     static T ConvertBytes(const uint8_t *bytes, ItemType type, DecodeType decoder);
-    uint8_t *LoadBinaryDataFromLogFile(uint64_t index_in_file, uint32_t size);
+    // Binary data is loaded from mapped log file, so it can be loaded by multiple threads at the same time.
+    uint8_t *LoadBinaryDataFromLogFile(uint64_t index_in_file, uint32_t size) const;
+    // Binary data is copied out of log file only once, then it is shared by all views until evicted from payload cache.
+    BinaryDataView LoadBinaryDataViewFromLogFile(uint64_t index_in_file, uint32_t size) const;
+    // Each request is [index_in_file, size]. Requests are fetched by 'num_of_threads_for_loading' threads.
+    bool LoadBinaryDataViewsFromLogFile(const std::vector<std::pair<uint64_t, uint32_t>> &requests, std::vector<BinaryDataView> &views) const;
 
-    // Support for csv loader.
-    static bool CreateLogFileByCsvFile(const std::string &csv_file_name, const std::string &log_file_name = "data.binlog");
+    // Support for column extraction. Packages should be fully loaded, and only items with static size can be extracted.
+    // kVector3 is expanded into 3 columns of x, y, z. kPose6Dof is expanded into 7 columns of p_x, p_y, p_z, q_w, q_x, q_y, q_z.
+    bool ExtractItemColumn(const uint16_t package_id, const std::string &item_name, std::vector<float> &column) const;
+    bool ExtractItemColumn(const uint16_t package_id, const std::string &item_name, std::vector<double> &column) const;
+    bool ExtractItemColumns(const uint16_t package_id, const std::string &item_name, std::vector<std::vector<float>> &columns) const;
+    bool ExtractItemColumns(const uint16_t package_id, const std::string &item_name, std::vector<std::vector<double>> &columns) const;
+    bool ExtractTimestampColumn(const uint16_t package_id, std::vector<float> &column) const;
+
+    // Support for batch decoder. Decode columns of components as ConvertBytes with DecodeType, but for all ticks at once.
+    // Quaternion is [w, x, y, z]. Items of kPose6Dof, kVector3 and consecutive kFloat can be decoded directly.
+    static bool DecodeColumns(const std::vector<std::vector<float>> &components, const DecodeType decoder, std::vector<float> &values,
+                              const uint32_t index_of_first_component = 0);
+    bool ExtractDecodedItemColumn(const uint16_t package_id, const std::string &item_name, const DecodeType decoder, std::vector<float> &column) const;
+
+    // Support for level of detail. Numeric items of static packages are summarized in pyramids of min, max and mean per time bucket, one
+    // pyramid per component as column extraction. Pyramids are built by the first query, or in advance by building, so plotting a time range
+    // costs O(num_of_buckets) instead of O(num_of_ticks). Use width of plot in pixels as 'num_of_buckets', and at least so many buckets are
+    // returned if there are enough ticks, but no more than kBranchFactor times of it. Few ticks in time range are returned as buckets of
+    // themselves. Ticks appended by follower are extracted and appended into pyramids only once.
+    bool BuildItemPyramids(const uint16_t package_id, const std::string &item_name);
+    bool QueryItemBuckets(const uint16_t package_id, const std::string &item_name, const float time_stamp_s_begin, const float time_stamp_s_end,
+                          const uint32_t num_of_buckets, std::vector<std::vector<TimeSeriesBucket>> &buckets_of_components);
+
+    // Support for streaming visitor. Frames are visited one by one in file order, without being stored in 'packages_id_with_data'.
+    // Packages to load are also applied here. Memory of visited part of log file is released, so log file can be larger than RAM.
+    bool VisitLogFile(const std::string &log_file_name, const PackageVisitor &visitor);
+
+    // Support for prefetcher. Dynamic packages near playback time are loaded into payload cache by a background thread, each one is
+    // [index_in_file, size_of_all_in_file] of its tick. Options of prefetcher are applied when starting. Loading log file again stops
+    // prefetcher, and refreshing followed log file pauses it until new ticks are merged.
+    bool StartPrefetching();
+    void StopPrefetching();
+    void UpdatePlaybackTime(const float playback_time_s, const bool is_playing_forward = true);
+    void WaitForPrefetching();
+    bool IsPrefetching() const { return prefetcher_thread_.joinable(); }
+
+    // Support for follower. Log file which is still being recorded can be followed, and only new complete frames are loaded by each refresh.
+    bool FollowLogFile(const std::string &log_file_name, bool load_dynamic_package_full_data = false);
+    bool RefreshFollowedLogFile();
+    void SubscribeNewTicks(const NewTicksSubscriber &subscriber);
+    bool IsFollowing() const { return is_following_; }
+
+    // Support for time query. Ticks of each package are sorted by timestamp after loading, so they are found by binary search.
+    // Ticks with timestamp in [time_stamp_s_begin, time_stamp_s_end] are [index_of_begin_tick, index_of_end_tick) of the loaded package,
+    // either in 'packages_id_with_data' or in 'packages_id_with_columns'. Nearest ticks are used for synchronizing packages.
+    bool Query(const uint16_t package_id, const float time_stamp_s_begin, const float time_stamp_s_end, uint32_t &index_of_begin_tick,
+               uint32_t &index_of_end_tick) const;
+    bool Query(const uint16_t package_id, const float time_stamp_s_begin, const float time_stamp_s_end, std::vector<PackageDataPerTick> &ticks) const;
+    bool QueryNearestTicks(const std::vector<uint16_t> &package_ids, const float time_stamp_s, std::vector<uint32_t> &indices_of_ticks) const;
+
+    // Support for csv loader. If more than one thread, lines of csv file are split into chunks and encoded in parallel, then recorded in order.
+    // Each scalar column is recorded in the narrowest type which holds all of its values exactly, e.g. kUint8 for flags and kDouble for
+    // values which lose precision in float. Types of columns in 'csv_column_types', keyed by name in csv header such as "imu/temperature",
+    // are forced instead. Conversion fails if any value is changed by the forced type of its column, e.g. 0.123456789 in float.
+    using CsvColumnTypes = std::unordered_map<std::string, ItemType>;
+    static bool CreateLogFileByCsvFile(const std::string &csv_file_name, const std::string &log_file_name = "data.binlog", const uint32_t num_of_threads = 1,
+                                       const CsvColumnTypes &csv_column_types = {});
+    // Csv from stream or file descriptor, e.g. a pipe, is read into a fixed-size buffer and recorded as lines arrive. Memory is bounded, so
+    // footer index is not recorded. Recording starts once the buffer is filled or csv ends. Since later lines are not seen, columns are
+    // recorded in double unless csv ends within buffer, and narrower types should be forced.
+    static bool CreateLogFileByCsvStream(std::istream &csv_stream, const std::string &log_file_name = "data.binlog", const CsvColumnTypes &csv_column_types = {});
+    static bool CreateLogFileByCsvFileDescriptor(const int32_t file_descriptor, const std::string &log_file_name = "data.binlog",
+                                                 const CsvColumnTypes &csv_column_types = {});
+    // Lines of all csv files are merged by absolute timestamp into one log file, with the same timestamp offset. Each csv file is parsed by
+    // its own thread, after types of its columns are inferred by all cores. Package ids of each csv file are offset by number of columns
+    // of csv files before it, so they are unique.
+    static bool CreateLogFileByCsvFiles(const std::vector<std::string> &csv_file_names, const std::string &log_file_name = "data.binlog",
+                                        const CsvColumnTypes &csv_column_types = {});
 
     // Support for information.
     void ReportAllRegisteredPackages();
@@ -65,56 +162,270 @@ public:
 
     // Reference for member variables.
     float &current_recorded_time_stamp_s() { return current_recorded_time_stamp_s_; }
+    bool &record_footer_index() { return record_footer_index_; }
+    uint32_t &num_of_threads_for_loading() { return num_of_threads_for_loading_; }
+    bool &load_static_package_in_columns() { return load_static_package_in_columns_; }
+    bool &use_sidecar_index() { return use_sidecar_index_; }
+    BinaryDataLogPayloadCache &payload_cache() { return payload_cache_; }
+    float &prefetch_window_s() { return prefetch_window_s_; }
+    uint64_t &prefetch_window_size() { return prefetch_window_size_; }
+    std::unordered_set<uint16_t> &package_ids_to_prefetch() { return package_ids_to_prefetch_; }
+    std::unordered_set<uint16_t> &package_ids_to_load() { return package_ids_to_load_; }
+    std::unordered_set<std::string> &package_names_to_load() { return package_names_to_load_; }
 
     // Const Reference for member variables.
     // Support for decodec.
-    const std::unique_ptr<std::ifstream> &file_r_ptr() const { return file_r_ptr_; }
+    const BinaryDataLogMappedFile &mapped_file_r() const { return mapped_file_r_; }
+    // Log file is no longer read by stream. Stream of loaded log file is opened again by each call, and nullptr if no log file is loaded.
+    [[deprecated("Use mapped_file_r() instead.")]] const std::unique_ptr<std::ifstream> &file_r_ptr() const;
     const std::map<uint16_t, std::unique_ptr<PackageInfo>> &packages_id_with_objects() const { return packages_id_with_objects_; }
     const std::pair<float, float> &timestamp_s_range_of_loaded_log() const { return timestamp_s_range_of_loaded_log_; }
+    const FrameCheckType &frame_check_type() const { return frame_check_type_; }
+    const uint32_t &num_of_threads_for_loading() const { return num_of_threads_for_loading_; }
+    const bool &load_static_package_in_columns() const { return load_static_package_in_columns_; }
+    const bool &use_sidecar_index() const { return use_sidecar_index_; }
+    const BinaryDataLogPayloadCache &payload_cache() const { return payload_cache_; }
+    const float &prefetch_window_s() const { return prefetch_window_s_; }
+    const uint64_t &prefetch_window_size() const { return prefetch_window_size_; }
+    const std::unordered_set<uint16_t> &package_ids_to_prefetch() const { return package_ids_to_prefetch_; }
+    const std::unordered_set<uint16_t> &package_ids_to_load() const { return package_ids_to_load_; }
+    const std::unordered_set<std::string> &package_names_to_load() const { return package_names_to_load_; }
     // Support for recorder.
     const std::unique_ptr<std::fstream> &file_w_ptr() const { return file_w_ptr_; }
     const std::chrono::time_point<std::chrono::system_clock> &start_system_time() const { return start_system_time_; }
     const float &current_recorded_time_stamp_s() const { return current_recorded_time_stamp_s_; }
+    const bool &record_footer_index() const { return record_footer_index_; }
     // Support for decoder.
     const std::unordered_map<uint16_t, std::vector<PackageDataPerTick>> &packages_id_with_data() const { return packages_id_with_data_; }
+    const std::unordered_map<uint16_t, PackageDataColumns> &packages_id_with_columns() const { return packages_id_with_columns_; }
 
 private:
-    // Support for decodec.
-    uint8_t SummaryBytes(const uint8_t *byte_ptr, const uint32_t size, const uint8_t init_value);
-    std::string LoadStringFromBinaryFile(uint32_t size);
+    // Support for recorder.
+    // Bytes of frames are serialized here before commit. Only grows, so it will not be reallocated for each frame.
+    struct StagingBuffer {
+        std::vector<char> bytes;
+        uint32_t size = 0;
+    };
+
+    // Support for decoder.
+    // Packages decoded from a range of log file. Ranges are merged in file order.
+    struct DecodedPackages {
+        std::unordered_map<uint16_t, std::vector<PackageDataPerTick>> packages_id_with_data;
+        std::unordered_map<uint16_t, PackageDataColumns> packages_id_with_columns;
+        std::pair<float, float> timestamp_s_range = std::make_pair(INFINITY, -INFINITY);
+    };
+
+    // Support for csv loader.
+    // Columns of csv file gathered into one package, in the order of items.
+    struct CsvPackageGatherPlan {
+        uint16_t package_id = 0;
+        std::vector<uint32_t> indices_of_columns;
+        std::vector<ItemType> types_of_columns;
+        // Values of columns with forced types are checked, since they may be changed. Inferred types hold all values exactly.
+        std::vector<bool> is_type_forced_of_columns;
+        uint32_t size_of_data = 0;
+    };
+    // Decided by header and the first valid line of csv file, then used for all lines.
+    struct CsvRecordingPlan {
+        std::vector<CsvPackageGatherPlan> gather_plans;
+        uint32_t num_of_values = 0;
+        uint32_t index_of_time_stamp = 0;
+        double time_stamp_offset_s = 0.0;
+        double time_stamp_scale = 1.0;
+    };
+    // Read at most 'size' bytes into 'bytes'. Return number of read bytes, 0 at the end and negative value for error.
+    using CsvBytesReader = std::function<int64_t(char *bytes, const uint64_t size)>;
+
+    // Support for csv merger.
+    // Each csv file is parsed by its own thread, and lines are passed to merger in batches.
+    struct CsvFileToMerge;
+
+private:
+    // Support for frame check.
+    static uint8_t SummaryBytes(const uint8_t *byte_ptr, const uint32_t size, const uint8_t init_value);
+    static uint32_t Crc32cBytes(const uint8_t *byte_ptr, const uint32_t size, const uint32_t init_value);
+    uint32_t UpdateFrameCheckValue(const uint8_t *byte_ptr, const uint32_t size, const uint32_t check_value) const;
+    uint32_t FrameCheckSize() const { return frame_check_type_ == FrameCheckType::kCrc32c ? 4 : 1; }
 
     // Support for recorder.
+    static StagingBuffer &StagingBufferOfThisThread();
+    static char *AllocateBytesInStagingBuffer(const uint32_t size);
+    void WriteBytesToLogFile(const char *data_ptr, const uint32_t size);
+    void CommitStagedBytesToLogFile(const bool record_in_index = false);
+    void RecordFrameInIndex(const uint64_t index_in_file, const char *frame_ptr, const uint32_t size);
+    char *BeginFrameInStagingBuffer(const uint16_t package_id, const float time_stamp_s, const uint32_t data_size);
+    void EndFrameInStagingBuffer(const bool record_in_index = true);
+    void SealFrameInStagingBuffer(const uint32_t index_of_frame_in_staging_buffer) const;
+    void CommitStagedFramesToLogFile();
+    bool RecordFooterIndex();
     void WriteLogFileHeader();
     bool RecordAllRegisteredPackagesAsFileHead();
     float GetSystemTimestamp();
     bool RecordImage(const uint16_t package_id, const int32_t channels, const int32_t image_rows, const int32_t image_cols, const uint8_t *data_ptr,
                      const float time_stamp_s);
 
+    // Support for asynchronous recorder.
+    void CommitBytesToAsyncRingBuffer(const char *data_ptr, const uint64_t size, const bool record_in_index);
+    void AsyncWriterLoop();
+
     // Support for decoder.
     bool CheckLogFileHeader();
     bool LoadRegisteredPackagesFromFileHead();
-    bool LoadOnePackage(bool load_full_data = true);
-    bool LoadOnePackageWithStaticSize(uint8_t &sum_check_byte, PackageDataPerTick &timestamped_data, uint16_t package_id, uint32_t data_size,
-                                      bool load_full_data);
-    bool LoadOnePackageWithDynamicSize(PackageInfo &package_info, uint8_t &sum_check_byte, PackageDataPerTick &timestamped_data, uint16_t package_id,
-                                       bool load_full_data);
+    void SelectPackagesToLoad();
+    bool IsPackageSelectedToLoad(const uint16_t package_id) const { return is_package_id_selected_.empty() || is_package_id_selected_[package_id]; }
+    void LoadAllPackages(bool load_dynamic_package_full_data, bool load_static_package_full_data);
+    void LoadAllPackagesInParallel(bool load_dynamic_package_full_data, bool load_static_package_full_data);
+    uint64_t LoadPackagesInRange(uint64_t index_in_file, const uint64_t end_index_in_file, bool load_dynamic_package_full_data,
+                                 bool load_static_package_full_data, DecodedPackages &decoded_packages) const;
+    void MergeDecodedPackages(DecodedPackages &decoded_packages);
+    bool IsFrameBeginningInLogFile(const uint64_t index_in_file) const;
+    uint64_t FindFirstFrameInRange(const uint64_t index_in_file, const uint64_t end_index_in_file) const;
+    bool LoadOnePackage(uint64_t &index_in_file, DecodedPackages &decoded_packages, bool load_dynamic_package_full_data = true,
+                        bool load_static_package_full_data = true) const;
+    bool LoadFooterIndex();
+    bool CheckFrameInLogFile(const uint64_t index_in_file, const uint32_t size_except_check) const;
+    bool ComputeDataSizeOfDynamicPackage(const ItemType type, const uint64_t index_in_file_of_data, uint32_t &data_size) const;
+    bool LoadOnePackageWithStaticSize(PackageDataPerTick &timestamped_data, uint16_t package_id, uint32_t data_size, bool load_full_data,
+                                      DecodedPackages &decoded_packages) const;
+    bool LoadOnePackageWithDynamicSize(const PackageInfo &package_info, PackageDataPerTick &timestamped_data, uint16_t package_id, bool load_full_data,
+                                       DecodedPackages &decoded_packages) const;
+
+    // Support for payload cache.
+    BinaryDataView CopyBinaryDataViewFromLogFile(uint64_t index_in_file, uint32_t size) const;
+
+    // Support for sidecar index.
+    std::string SidecarIndexFileName() const;
+    bool SaveSidecarIndex() const;
+    bool LoadSidecarIndex(bool load_dynamic_package_full_data, bool load_static_package_full_data);
+
+    // Support for follower.
+    bool LoadNewFramesOfFollowedLogFile();
+
+    // Support for prefetcher.
+    void PrefetcherLoop();
+    void PrefetchPayloadsNearPlaybackTime(const float playback_time_s, const bool is_playing_forward);
+
+    // Support for column extraction. Only ticks in [index_of_begin_tick, index_of_end_tick) are extracted.
+    template <typename T>
+    bool ExtractItemColumnsOfType(const uint16_t package_id, const std::string &item_name, const uint64_t index_of_begin_tick,
+                                  const uint64_t index_of_end_tick, std::vector<std::vector<T>> &columns) const;
+    bool ExtractItemColumns(const uint16_t package_id, const std::string &item_name, const uint64_t index_of_begin_tick, const uint64_t index_of_end_tick,
+                            std::vector<std::vector<float>> &columns) const;
+    bool ExtractTimestampColumn(const uint16_t package_id, const uint64_t index_of_begin_tick, const uint64_t index_of_end_tick,
+                                std::vector<float> &column) const;
+
+    // Support for time query.
+    void SortLoadedPackagesByTimestamp();
 
     // Support for csv loader.
     static bool ParseTimestampInCsvHeader(const std::string &csv_header_name, double &timestamp_scale);
+    static const char *FindCsvLineEnd(const char *line_begin, const char *csv_end);
+    // Spaces are ignored and empty values are skipped. Return false if the number of values is not 'num_of_values', or any value cannot be parsed.
+    static bool ParseCsvLine(const char *line_begin, const char *line_end, const uint32_t num_of_values, std::vector<double> &values);
+    // Find the first line which can be parsed, before the first empty line. If not found, 'line_begin' is the empty line or the end of lines.
+    static bool FindFirstValidCsvLine(const char *lines_begin, const char *lines_end, const uint32_t num_of_values, std::vector<double> &values,
+                                      const char *&line_begin, uint32_t &num_of_skipped_lines);
+    // Types of columns are inferred from valid lines in [lines_begin, lines_end), before the first empty line. Narrower types than double
+    // are inferred only if these are all lines of csv. It is an extra pass over all lines before recording, which parses each value and
+    // prints those inexact in float, so lines are split into parts and scanned by 'num_of_threads' threads.
+    static bool InferTypesOfCsvColumns(const std::vector<std::string> &csv_header_items, const char *lines_begin, const char *lines_end,
+                                       const bool is_all_lines, const uint32_t num_of_threads, const CsvColumnTypes &csv_column_types,
+                                       std::vector<ItemType> &types_of_columns);
+    static bool CreateLogFileByCsvReader(const CsvBytesReader &read_bytes, const std::string &csv_name, const std::string &log_file_name,
+                                         const CsvColumnTypes &csv_column_types);
+    bool PrepareForRecordingCsv(const std::string &csv_header, const char *lines_begin, const char *lines_end, const bool is_all_lines,
+                                const uint32_t num_of_threads, const std::string &csv_name, const std::string &log_file_name,
+                                const CsvColumnTypes &csv_column_types, CsvRecordingPlan &plan);
+    bool RegisterPackagesByCsvHeader(const std::string &csv_header, const char *lines_begin, const char *lines_end, const bool is_all_lines,
+                                     const uint32_t num_of_threads, const std::string &csv_name, const uint16_t base_package_id,
+                                     const std::string &default_package_name, const CsvColumnTypes &csv_column_types, CsvRecordingPlan &plan);
+    void RecordCsvLines(const char *lines_begin, const char *lines_end, const CsvRecordingPlan &plan, const uint32_t num_of_threads,
+                        uint32_t &num_of_skipped_lines, uint32_t &num_of_inexact_lines);
+    bool EncodeCsvLinesInStagingBuffer(const char *lines_begin, const char *lines_end, const CsvRecordingPlan &plan, uint32_t &num_of_skipped_lines,
+                                       uint32_t &num_of_inexact_lines, float &last_time_stamp_s);
+    // Return false if any value is changed by forced type of its column.
+    bool EncodeCsvValuesInStagingBuffer(const CsvRecordingPlan &plan, const double *values, const float time_stamp_s);
 
 private:
     // Support for decodec.
-    std::unique_ptr<std::ifstream> file_r_ptr_ = nullptr;
+    // Log file is mapped into memory, all packages are parsed from mapped region directly.
+    BinaryDataLogMappedFile mapped_file_r_;
+    // Only opened by deprecated file_r_ptr().
+    mutable std::unique_ptr<std::ifstream> file_r_ptr_ = nullptr;
+    // Index in file of the first package content, which is right after registered packages.
+    uint64_t index_in_file_of_content_ = 0;
+    // If more than one thread, log file is split into ranges and loaded in parallel.
+    uint32_t num_of_threads_for_loading_ = 1;
+    // If true, fully loaded packages with static size are stored in 'packages_id_with_columns_' instead of 'packages_id_with_data_'.
+    bool load_static_package_in_columns_ = false;
+    // If not empty, only packages with these ids or names are loaded. Frames of other packages are skipped by offset, without check.
+    std::unordered_set<uint16_t> package_ids_to_load_;
+    std::unordered_set<std::string> package_names_to_load_;
+    // Resolved from ids and names to load after registered packages are loaded. Empty means all packages are selected.
+    std::vector<bool> is_package_id_selected_;
+    // Followed log file is loaded until this index in file, which is the end of the last complete frame.
+    bool is_following_ = false;
+    bool follow_dynamic_package_full_data_ = false;
+    uint64_t index_in_file_of_followed_ = 0;
+    std::vector<NewTicksSubscriber> new_ticks_subscribers_;
+    // Binary data recently loaded by views. It is cleared when another log file is loaded.
+    mutable BinaryDataLogPayloadCache payload_cache_;
+    // After log file is scanned by loading, index of all frames is saved as '<log_file_name>.idx', keyed by size, modified time and
+    // registered packages of log file. Reopening the same log file loads frames by this index, without scanning and checking them again.
+    bool use_sidecar_index_ = true;
+    // Pyramids of items for level of detail. They are cleared when another log file is loaded.
+    std::unordered_map<uint16_t, std::unordered_map<std::string, std::vector<BinaryDataLogItemPyramid>>> packages_id_with_item_pyramids_;
     std::map<uint16_t, std::unique_ptr<PackageInfo>> packages_id_with_objects_;
     std::pair<float, float> timestamp_s_range_of_loaded_log_ = std::make_pair(0, 0);
+    FrameCheckType frame_check_type_ = FrameCheckType::kSummaryByte;
+
+    // Support for prefetcher.
+    // Payloads within this time window after playback time are prefetched, but no more than this size of bytes.
+    float prefetch_window_s_ = 2.0f;
+    uint64_t prefetch_window_size_ = 64 * 1024 * 1024;
+    // If empty, all packages with dynamic size are prefetched.
+    std::unordered_set<uint16_t> package_ids_to_prefetch_;
+    std::thread prefetcher_thread_;
+    std::mutex prefetcher_mutex_;
+    std::condition_variable prefetcher_signal_;
+    std::condition_variable prefetcher_idle_signal_;
+    // Requests from foreground are protected by mutex. Prefetching is abandoned once a new playback time is updated.
+    std::atomic<bool> prefetcher_stop_ = false;
+    bool prefetcher_idle_ = true;
+    std::atomic<bool> has_new_playback_time_ = false;
+    float playback_time_s_ = 0.0f;
+    bool is_playing_forward_ = true;
+    // Options copied when prefetcher starts.
+    float prefetcher_window_s_ = 0.0f;
+    uint64_t prefetcher_window_size_ = 0;
+    std::vector<uint16_t> prefetcher_package_ids_;
 
     // Support for recorder.
     std::unique_ptr<std::fstream> file_w_ptr_ = nullptr;
     std::chrono::time_point<std::chrono::system_clock> start_system_time_ = std::chrono::system_clock::now();
     float current_recorded_time_stamp_s_ = 0.0f;
+    std::mutex file_w_mutex_;
+    // Number of bytes committed to log file, which is the index in file of the next frame.
+    uint64_t committed_size_in_file_ = 0;
+    bool is_file_head_recorded_ = false;
+    bool record_footer_index_ = true;
+    std::map<uint16_t, std::vector<PackageIndexPerTick>> packages_id_with_index_;
+
+    // Support for asynchronous recorder.
+    // All indices are monotonic index in file, position in ring buffer is index % size.
+    // Recorders reserve [reserve, reserve + n), then publish them in order by moving commit index.
+    // Writer thread writes [read, commit) into log file.
+    std::vector<char> async_ring_buffer_;
+    std::atomic<uint64_t> async_ring_reserve_index_ = 0;
+    std::atomic<uint64_t> async_ring_commit_index_ = 0;
+    std::atomic<uint64_t> async_ring_read_index_ = 0;
+    std::atomic<uint32_t> async_writer_signal_ = 0;
+    std::atomic<bool> async_writer_stop_ = false;
+    std::thread async_writer_thread_;
 
     // Support for decoder.
     std::unordered_map<uint16_t, std::vector<PackageDataPerTick>> packages_id_with_data_;
+    std::unordered_map<uint16_t, PackageDataColumns> packages_id_with_columns_;
 };
 
 /* Class BinaryDataLog Definition. */
@@ -0,0 +1,159 @@
+#include "binary_data_log.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "array"
+#include "cstring"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include "immintrin.h"
+#define BINARY_DATA_LOG_X86_KERNELS
+#endif
+
+namespace slam_data_log {
+
+namespace {
+    using SummaryBytesKernel = uint8_t (*)(const uint8_t *, uint32_t, uint8_t);
+    using Crc32cBytesKernel = uint32_t (*)(const uint8_t *, uint32_t, uint32_t);
+
+    uint8_t SummaryBytesScalar(const uint8_t *byte_ptr, uint32_t size, uint8_t init_value) {
+        uint8_t value = init_value;
+        for (uint32_t i = 0; i < size; ++i) {
+            value += byte_ptr[i];
+        }
+        return value;
+    }
+
+    // Reflected polynomial of CRC32C (Castagnoli).
+    constexpr uint32_t kCrc32cPolynomial = 0x82F63B78u;
+
+    constexpr std::array<uint32_t, 256> GenerateCrc32cTable() {
+        std::array<uint32_t, 256> table {};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (uint32_t j = 0; j < 8; ++j) {
+                crc = (crc >> 1) ^ ((crc & 1u) ? kCrc32cPolynomial : 0u);
+            }
+            table[i] = crc;
+        }
+        return table;
+    }
+
+    constexpr std::array<uint32_t, 256> kCrc32cTable = GenerateCrc32cTable();
+
+    uint32_t Crc32cBytesScalar(const uint8_t *byte_ptr, uint32_t size, uint32_t init_value) {
+        uint32_t crc = ~init_value;
+        for (uint32_t i = 0; i < size; ++i) {
+            crc = kCrc32cTable[(crc ^ byte_ptr[i]) & 0xFFu] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+#ifdef BINARY_DATA_LOG_X86_KERNELS
+    // Sum of bytes modulo 256 is the low byte of sum of absolute difference with zero.
+    __attribute__((target("sse2"))) uint8_t SummaryBytesSse2(const uint8_t *byte_ptr, uint32_t size, uint8_t init_value) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i sum_0 = _mm_setzero_si128();
+        __m128i sum_1 = _mm_setzero_si128();
+        uint32_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            const __m128i bytes_0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(byte_ptr + i));
+            const __m128i bytes_1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(byte_ptr + i + 16));
+            sum_0 = _mm_add_epi64(sum_0, _mm_sad_epu8(bytes_0, zero));
+            sum_1 = _mm_add_epi64(sum_1, _mm_sad_epu8(bytes_1, zero));
+        }
+        const __m128i sum = _mm_add_epi64(sum_0, sum_1);
+        const uint8_t value = static_cast<uint8_t>(init_value + _mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(sum, sum)));
+        return SummaryBytesScalar(byte_ptr + i, size - i, value);
+    }
+
+    __attribute__((target("avx2"))) uint8_t SummaryBytesAvx2(const uint8_t *byte_ptr, uint32_t size, uint8_t init_value) {
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i sum_0 = _mm256_setzero_si256();
+        __m256i sum_1 = _mm256_setzero_si256();
+        uint32_t i = 0;
+        for (; i + 64 <= size; i += 64) {
+            const __m256i bytes_0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(byte_ptr + i));
+            const __m256i bytes_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(byte_ptr + i + 32));
+            sum_0 = _mm256_add_epi64(sum_0, _mm256_sad_epu8(bytes_0, zero));
+            sum_1 = _mm256_add_epi64(sum_1, _mm256_sad_epu8(bytes_1, zero));
+        }
+        const __m256i sum_256 = _mm256_add_epi64(sum_0, sum_1);
+        const __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(sum_256), _mm256_extracti128_si256(sum_256, 1));
+        const uint8_t value = static_cast<uint8_t>(init_value + _mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(sum, sum)));
+        return SummaryBytesSse2(byte_ptr + i, size - i, value);
+    }
+
+    __attribute__((target("sse4.2"))) uint32_t Crc32cBytesSse42(const uint8_t *byte_ptr, uint32_t size, uint32_t init_value) {
+        uint32_t i = 0;
+#if defined(__x86_64__)
+        uint64_t crc = ~init_value;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t word = 0;
+            std::memcpy(&word, byte_ptr + i, 8);
+            crc = _mm_crc32_u64(crc, word);
+        }
+        uint32_t crc_32 = static_cast<uint32_t>(crc);
+#else
+        uint32_t crc_32 = ~init_value;
+#endif
+        for (; i + 4 <= size; i += 4) {
+            uint32_t word = 0;
+            std::memcpy(&word, byte_ptr + i, 4);
+            crc_32 = _mm_crc32_u32(crc_32, word);
+        }
+        for (; i < size; ++i) {
+            crc_32 = _mm_crc32_u8(crc_32, byte_ptr[i]);
+        }
+        return ~crc_32;
+    }
+#endif
+
+    SummaryBytesKernel SelectSummaryBytesKernel() {
+#ifdef BINARY_DATA_LOG_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return SummaryBytesAvx2;
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return SummaryBytesSse2;
+        }
+#endif
+        return SummaryBytesScalar;
+    }
+
+    Crc32cBytesKernel SelectCrc32cBytesKernel() {
+#ifdef BINARY_DATA_LOG_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse4.2")) {
+            return Crc32cBytesSse42;
+        }
+#endif
+        return Crc32cBytesScalar;
+    }
+
+    // Small pieces such as offset, id and timestamp are not worth a function pointer call of simd kernel.
+    constexpr uint32_t kMinBytesForSimdKernels = 32;
+}  // namespace
+
+uint8_t BinaryDataLog::SummaryBytes(const uint8_t *byte_ptr, const uint32_t size, const uint8_t init_value) {
+    if (size < kMinBytesForSimdKernels) {
+        return SummaryBytesScalar(byte_ptr, size, init_value);
+    }
+    static const SummaryBytesKernel kernel = SelectSummaryBytesKernel();
+    return kernel(byte_ptr, size, init_value);
+}
+
+uint32_t BinaryDataLog::Crc32cBytes(const uint8_t *byte_ptr, const uint32_t size, const uint32_t init_value) {
+    static const Crc32cBytesKernel kernel = SelectCrc32cBytesKernel();
+    return kernel(byte_ptr, size, init_value);
+}
+
+uint32_t BinaryDataLog::UpdateFrameCheckValue(const uint8_t *byte_ptr, const uint32_t size, const uint32_t check_value) const {
+    if (frame_check_type_ == FrameCheckType::kCrc32c) {
+        return Crc32cBytes(byte_ptr, size, check_value);
+    }
+    return SummaryBytes(byte_ptr, size, static_cast<uint8_t>(check_value));
+}
+
+}  // namespace slam_data_log
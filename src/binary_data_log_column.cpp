@@ -0,0 +1,358 @@
+#include "binary_data_log.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "algorithm"
+#include "array"
+#include "cstring"
+#include "limits"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include "immintrin.h"
+#define BINARY_DATA_LOG_X86_KERNELS
+#endif
+
+namespace slam_data_log {
+
+namespace {
+    // Ticks are extracted block by block, so all components of one item are extracted while the block is still in cache.
+    constexpr uint64_t kNumOfTicksPerBlock = 1024;
+
+    // Items of kVector3 and kPose6Dof are expanded into components of float.
+    struct ItemComponent {
+        ItemType type = ItemType::kFloat;
+        uint32_t index_in_package = 0;
+    };
+
+    template <typename ItemT, typename T>
+    void ExtractStridedItemScalar(const uint8_t *item_ptr, const uint64_t stride, const uint64_t num_of_ticks, T *column) {
+        for (uint64_t i = 0; i < num_of_ticks; ++i) {
+            ItemT value;
+            std::memcpy(&value, item_ptr + i * stride, sizeof(ItemT));
+            column[i] = static_cast<T>(value);
+        }
+    }
+
+    template <typename ItemT, typename T>
+    void ExtractTickItemScalar(const uint8_t *const *tick_ptrs, const uint64_t num_of_ticks, const uint32_t index_in_package, T *column) {
+        for (uint64_t i = 0; i < num_of_ticks; ++i) {
+            ItemT value;
+            std::memcpy(&value, tick_ptrs[i] + index_in_package, sizeof(ItemT));
+            column[i] = static_cast<T>(value);
+        }
+    }
+
+    // The switch of item type is decided once for the whole column, not for each tick.
+    template <typename T>
+    void ExtractStridedItem(const uint8_t *item_ptr, const uint64_t stride, const uint64_t num_of_ticks, const ItemType type, T *column) {
+        switch (type) {
+            case ItemType::kUint8: return ExtractStridedItemScalar<uint8_t>(item_ptr, stride, num_of_ticks, column);
+            case ItemType::kInt8: return ExtractStridedItemScalar<int8_t>(item_ptr, stride, num_of_ticks, column);
+            case ItemType::kUint16: return ExtractStridedItemScalar<uint16_t>(item_ptr, stride, num_of_ticks, column);
+            case ItemType::kInt16: return ExtractStridedItemScalar<int16_t>(item_ptr, stride, num_of_ticks, column);
+            case ItemType::kUint32: return ExtractStridedItemScalar<uint32_t>(item_ptr, stride, num_of_ticks, column);
+            case ItemType::kInt32: return ExtractStridedItemScalar<int32_t>(item_ptr, stride, num_of_ticks, column);
+            case ItemType::kUint64: return ExtractStridedItemScalar<uint64_t>(item_ptr, stride, num_of_ticks, column);
+            case ItemType::kInt64: return ExtractStridedItemScalar<int64_t>(item_ptr, stride, num_of_ticks, column);
+            case ItemType::kFloat: return ExtractStridedItemScalar<float>(item_ptr, stride, num_of_ticks, column);
+            case ItemType::kDouble: return ExtractStridedItemScalar<double>(item_ptr, stride, num_of_ticks, column);
+            default: return;
+        }
+    }
+
+    template <typename T>
+    void ExtractTickItem(const uint8_t *const *tick_ptrs, const uint64_t num_of_ticks, const uint32_t index_in_package, const ItemType type, T *column) {
+        switch (type) {
+            case ItemType::kUint8: return ExtractTickItemScalar<uint8_t>(tick_ptrs, num_of_ticks, index_in_package, column);
+            case ItemType::kInt8: return ExtractTickItemScalar<int8_t>(tick_ptrs, num_of_ticks, index_in_package, column);
+            case ItemType::kUint16: return ExtractTickItemScalar<uint16_t>(tick_ptrs, num_of_ticks, index_in_package, column);
+            case ItemType::kInt16: return ExtractTickItemScalar<int16_t>(tick_ptrs, num_of_ticks, index_in_package, column);
+            case ItemType::kUint32: return ExtractTickItemScalar<uint32_t>(tick_ptrs, num_of_ticks, index_in_package, column);
+            case ItemType::kInt32: return ExtractTickItemScalar<int32_t>(tick_ptrs, num_of_ticks, index_in_package, column);
+            case ItemType::kUint64: return ExtractTickItemScalar<uint64_t>(tick_ptrs, num_of_ticks, index_in_package, column);
+            case ItemType::kInt64: return ExtractTickItemScalar<int64_t>(tick_ptrs, num_of_ticks, index_in_package, column);
+            case ItemType::kFloat: return ExtractTickItemScalar<float>(tick_ptrs, num_of_ticks, index_in_package, column);
+            case ItemType::kDouble: return ExtractTickItemScalar<double>(tick_ptrs, num_of_ticks, index_in_package, column);
+            default: return;
+        }
+    }
+
+#ifdef BINARY_DATA_LOG_X86_KERNELS
+    __attribute__((target("avx2"))) inline void StoreLanes(const __m256 values, float *column) { _mm256_storeu_ps(column, values); }
+
+    __attribute__((target("avx2"))) inline void StoreLanes(const __m256 values, double *column) {
+        _mm256_storeu_pd(column, _mm256_cvtps_pd(_mm256_castps256_ps128(values)));
+        _mm256_storeu_pd(column + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(values, 1)));
+    }
+
+    __attribute__((target("avx2"))) inline void StoreLanes(const __m256i values, float *column) { _mm256_storeu_ps(column, _mm256_cvtepi32_ps(values)); }
+
+    __attribute__((target("avx2"))) inline void StoreLanes(const __m256i values, double *column) {
+        _mm256_storeu_pd(column, _mm256_cvtepi32_pd(_mm256_castsi256_si128(values)));
+        _mm256_storeu_pd(column + 4, _mm256_cvtepi32_pd(_mm256_extracti128_si256(values, 1)));
+    }
+
+    // Unsigned 32 bits is converted by two exact halves of 16 bits, so it is rounded only once as scalar conversion.
+    __attribute__((target("avx2"))) inline void StoreUnsignedLanes(const __m256i values, float *column) {
+        const __m256 low = _mm256_cvtepi32_ps(_mm256_and_si256(values, _mm256_set1_epi32(0xFFFF)));
+        const __m256 high = _mm256_cvtepi32_ps(_mm256_srli_epi32(values, 16));
+        _mm256_storeu_ps(column, _mm256_add_ps(_mm256_mul_ps(high, _mm256_set1_ps(65536.0f)), low));
+    }
+
+    __attribute__((target("avx2"))) inline void StoreUnsignedLanes(const __m256i values, double *column) {
+        const __m256i low = _mm256_and_si256(values, _mm256_set1_epi32(0xFFFF));
+        const __m256i high = _mm256_srli_epi32(values, 16);
+        const __m256d scale = _mm256_set1_pd(65536.0);
+        _mm256_storeu_pd(column, _mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(high)), scale),
+                                               _mm256_cvtepi32_pd(_mm256_castsi256_si128(low))));
+        _mm256_storeu_pd(column + 4, _mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(high, 1)), scale),
+                                                   _mm256_cvtepi32_pd(_mm256_extracti128_si256(low, 1))));
+    }
+
+    __attribute__((target("avx2"))) inline void StoreDoubleLanes(const __m256d low, const __m256d high, float *column) {
+        _mm256_storeu_ps(column, _mm256_set_m128(_mm256_cvtpd_ps(high), _mm256_cvtpd_ps(low)));
+    }
+
+    __attribute__((target("avx2"))) inline void StoreDoubleLanes(const __m256d low, const __m256d high, double *column) {
+        _mm256_storeu_pd(column, low);
+        _mm256_storeu_pd(column + 4, high);
+    }
+
+    // Gather one item of 8 ticks at once. Indices of lanes are fixed as multiples of stride, only base pointer moves.
+    // Items less than 4 bytes are gathered as 4 bytes, so only ticks with enough bytes after item are extracted here.
+    // Return the number of extracted ticks, others are left for scalar kernel.
+    template <typename T>
+    __attribute__((target("avx2"))) uint64_t ExtractStridedItemAvx2(const uint8_t *item_ptr, const uint64_t stride, const uint64_t num_of_ticks,
+                                                                    const uint64_t num_of_safe_ticks, const ItemType type, T *column) {
+        const int32_t s = static_cast<int32_t>(stride);
+        const __m256i indices = _mm256_setr_epi32(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s);
+        uint64_t i = 0;
+        switch (type) {
+            case ItemType::kUint8:
+                for (; i + 8 <= num_of_safe_ticks; i += 8) {
+                    const __m256i values = _mm256_i32gather_epi32(reinterpret_cast<const int *>(item_ptr + i * stride), indices, 1);
+                    StoreLanes(_mm256_and_si256(values, _mm256_set1_epi32(0xFF)), column + i);
+                }
+                break;
+            case ItemType::kInt8:
+                for (; i + 8 <= num_of_safe_ticks; i += 8) {
+                    const __m256i values = _mm256_i32gather_epi32(reinterpret_cast<const int *>(item_ptr + i * stride), indices, 1);
+                    StoreLanes(_mm256_srai_epi32(_mm256_slli_epi32(values, 24), 24), column + i);
+                }
+                break;
+            case ItemType::kUint16:
+                for (; i + 8 <= num_of_safe_ticks; i += 8) {
+                    const __m256i values = _mm256_i32gather_epi32(reinterpret_cast<const int *>(item_ptr + i * stride), indices, 1);
+                    StoreLanes(_mm256_and_si256(values, _mm256_set1_epi32(0xFFFF)), column + i);
+                }
+                break;
+            case ItemType::kInt16:
+                for (; i + 8 <= num_of_safe_ticks; i += 8) {
+                    const __m256i values = _mm256_i32gather_epi32(reinterpret_cast<const int *>(item_ptr + i * stride), indices, 1);
+                    StoreLanes(_mm256_srai_epi32(_mm256_slli_epi32(values, 16), 16), column + i);
+                }
+                break;
+            case ItemType::kUint32:
+                for (; i + 8 <= num_of_ticks; i += 8) {
+                    StoreUnsignedLanes(_mm256_i32gather_epi32(reinterpret_cast<const int *>(item_ptr + i * stride), indices, 1), column + i);
+                }
+                break;
+            case ItemType::kInt32:
+                for (; i + 8 <= num_of_ticks; i += 8) {
+                    StoreLanes(_mm256_i32gather_epi32(reinterpret_cast<const int *>(item_ptr + i * stride), indices, 1), column + i);
+                }
+                break;
+            case ItemType::kFloat:
+                for (; i + 8 <= num_of_ticks; i += 8) {
+                    StoreLanes(_mm256_i32gather_ps(reinterpret_cast<const float *>(item_ptr + i * stride), indices, 1), column + i);
+                }
+                break;
+            case ItemType::kDouble:
+                for (; i + 8 <= num_of_ticks; i += 8) {
+                    const double *low_ptr = reinterpret_cast<const double *>(item_ptr + i * stride);
+                    const double *high_ptr = reinterpret_cast<const double *>(item_ptr + (i + 4) * stride);
+                    const __m128i low_indices = _mm256_castsi256_si128(indices);
+                    // Masked gather with zero source, since unmasked one reads an uninitialized source and warns with -Wall.
+                    const __m256d all_lanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+                    StoreDoubleLanes(_mm256_mask_i32gather_pd(_mm256_setzero_pd(), low_ptr, low_indices, all_lanes, 1),
+                                     _mm256_mask_i32gather_pd(_mm256_setzero_pd(), high_ptr, low_indices, all_lanes, 1), column + i);
+                }
+                break;
+            default:
+                // Items of 64 bits integer have no gather kernel.
+                break;
+        }
+        return i;
+    }
+
+    bool IsAvx2Supported() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    }
+#endif
+
+    template <typename T>
+    void ExtractStridedItemColumn(const uint8_t *item_ptr, const uint64_t stride, const uint64_t num_of_ticks, const uint64_t size_after_item_ptr,
+                                  const ItemType type, T *column) {
+        uint64_t num_of_extracted_ticks = 0;
+#ifdef BINARY_DATA_LOG_X86_KERNELS
+        static const bool kIsAvx2Supported = IsAvx2Supported();
+        if (kIsAvx2Supported && stride <= static_cast<uint64_t>(std::numeric_limits<int32_t>::max() / 8)) {
+            // Tick i is safe for gathering 4 bytes, if i * stride + 4 <= size after item pointer.
+            const uint64_t num_of_safe_ticks = size_after_item_ptr < 4 ? 0 : std::min(num_of_ticks, (size_after_item_ptr - 4) / stride + 1);
+            num_of_extracted_ticks = ExtractStridedItemAvx2(item_ptr, stride, num_of_ticks, num_of_safe_ticks, type, column);
+        }
+#endif
+        ExtractStridedItem(item_ptr + num_of_extracted_ticks * stride, stride, num_of_ticks - num_of_extracted_ticks, type,
+                           column + num_of_extracted_ticks);
+    }
+}  // namespace
+
+template <typename T>
+bool BinaryDataLog::ExtractItemColumnsOfType(const uint16_t package_id, const std::string &item_name, const uint64_t index_of_begin_tick,
+                                             const uint64_t index_of_end_tick, std::vector<std::vector<T>> &columns) const {
+    // Locate item in registered package.
+    const auto package_it = packages_id_with_objects_.find(package_id);
+    if (package_it == packages_id_with_objects_.end()) {
+        ReportWarn("[DataLog] Package id " << package_id << " is not registered.");
+        columns.clear();
+        return false;
+    }
+    const PackageInfo &package_info = *package_it->second;
+    const auto item_it =
+        std::find_if(package_info.items.begin(), package_info.items.end(), [&item_name](const PackageItemInfo &item) { return item.name == item_name; });
+    if (item_it == package_info.items.end()) {
+        ReportWarn("[DataLog] Item [" << item_name << "] is not found in package [id][" << package_id << "].");
+        columns.clear();
+        return false;
+    }
+
+    // Expand item into components.
+    std::vector<ItemComponent> components;
+    switch (item_it->type) {
+        case ItemType::kVector3:
+        case ItemType::kPose6Dof: {
+            const uint32_t num_of_components = item_type_sizes[static_cast<uint32_t>(item_it->type)] / sizeof(float);
+            for (uint32_t i = 0; i < num_of_components; ++i) {
+                components.emplace_back(ItemComponent {.type = ItemType::kFloat, .index_in_package = item_it->bindata_index_in_package + i * 4});
+            }
+            break;
+        }
+        default: {
+            if (IsDynamicType(item_it->type) || package_info.size == 0) {
+                ReportWarn("[DataLog] Item [" << item_name << "] of package [id][" << package_id << "] cannot be extracted as column.");
+                columns.clear();
+                return false;
+            }
+            components.emplace_back(ItemComponent {.type = item_it->type, .index_in_package = item_it->bindata_index_in_package});
+            break;
+        }
+    }
+
+    // Extract from columns with fixed stride.
+    const auto columns_it = packages_id_with_columns_.find(package_id);
+    if (columns_it != packages_id_with_columns_.end()) {
+        const PackageDataColumns &package_columns = columns_it->second;
+        const uint64_t end_tick = std::min<uint64_t>(index_of_end_tick, package_columns.size());
+        const uint64_t begin_tick = std::min(index_of_begin_tick, end_tick);
+        const uint64_t stride = package_columns.size_of_data;
+        columns.resize(components.size());
+        for (auto &column: columns) {
+            column.resize(end_tick - begin_tick);
+        }
+        for (uint64_t i = begin_tick; i < end_tick; i += kNumOfTicksPerBlock) {
+            const uint64_t num_of_ticks_in_block = std::min(kNumOfTicksPerBlock, end_tick - i);
+            for (uint32_t j = 0; j < components.size(); ++j) {
+                const uint64_t index_of_item = i * stride + components[j].index_in_package;
+                ExtractStridedItemColumn(package_columns.data.data() + index_of_item, stride, num_of_ticks_in_block, package_columns.data.size() - index_of_item,
+                                         components[j].type, columns[j].data() + i - begin_tick);
+            }
+        }
+        return true;
+    }
+
+    // Extract from ticks, whose data must be fully loaded.
+    const auto data_it = packages_id_with_data_.find(package_id);
+    const uint64_t end_tick = data_it == packages_id_with_data_.end() ? 0 : std::min<uint64_t>(index_of_end_tick, data_it->second.size());
+    const uint64_t begin_tick = std::min(index_of_begin_tick, end_tick);
+    columns.resize(components.size());
+    for (auto &column: columns) {
+        column.resize(end_tick - begin_tick);
+    }
+    std::array<const uint8_t *, kNumOfTicksPerBlock> tick_ptrs;
+    for (uint64_t i = begin_tick; i < end_tick; i += kNumOfTicksPerBlock) {
+        const uint64_t num_of_ticks_in_block = std::min(kNumOfTicksPerBlock, end_tick - i);
+        for (uint64_t k = 0; k < num_of_ticks_in_block; ++k) {
+            const auto &timestamped_data = data_it->second[i + k];
+            if (timestamped_data.data.size() < package_info.size) {
+                ReportWarn("[DataLog] Data of package [id][" << package_id << "] is not fully loaded.");
+                columns.clear();
+                return false;
+            }
+            tick_ptrs[k] = timestamped_data.data.data();
+        }
+        for (uint32_t j = 0; j < components.size(); ++j) {
+            ExtractTickItem(tick_ptrs.data(), num_of_ticks_in_block, components[j].index_in_package, components[j].type, columns[j].data() + i - begin_tick);
+        }
+    }
+
+    return true;
+}
+
+bool BinaryDataLog::ExtractItemColumn(const uint16_t package_id, const std::string &item_name, std::vector<float> &column) const {
+    std::vector<std::vector<float>> columns;
+    RETURN_FALSE_IF(!ExtractItemColumnsOfType(package_id, item_name, 0, UINT64_MAX, columns) || columns.size() != 1);
+    column = std::move(columns.front());
+    return true;
+}
+
+bool BinaryDataLog::ExtractItemColumn(const uint16_t package_id, const std::string &item_name, std::vector<double> &column) const {
+    std::vector<std::vector<double>> columns;
+    RETURN_FALSE_IF(!ExtractItemColumnsOfType(package_id, item_name, 0, UINT64_MAX, columns) || columns.size() != 1);
+    column = std::move(columns.front());
+    return true;
+}
+
+bool BinaryDataLog::ExtractItemColumns(const uint16_t package_id, const std::string &item_name, std::vector<std::vector<float>> &columns) const {
+    return ExtractItemColumnsOfType(package_id, item_name, 0, UINT64_MAX, columns);
+}
+
+bool BinaryDataLog::ExtractItemColumns(const uint16_t package_id, const std::string &item_name, std::vector<std::vector<double>> &columns) const {
+    return ExtractItemColumnsOfType(package_id, item_name, 0, UINT64_MAX, columns);
+}
+
+bool BinaryDataLog::ExtractItemColumns(const uint16_t package_id, const std::string &item_name, const uint64_t index_of_begin_tick,
+                                       const uint64_t index_of_end_tick, std::vector<std::vector<float>> &columns) const {
+    return ExtractItemColumnsOfType(package_id, item_name, index_of_begin_tick, index_of_end_tick, columns);
+}
+
+bool BinaryDataLog::ExtractTimestampColumn(const uint16_t package_id, std::vector<float> &column) const {
+    return ExtractTimestampColumn(package_id, 0, UINT64_MAX, column);
+}
+
+bool BinaryDataLog::ExtractTimestampColumn(const uint16_t package_id, const uint64_t index_of_begin_tick, const uint64_t index_of_end_tick,
+                                           std::vector<float> &column) const {
+    column.clear();
+    const auto columns_it = packages_id_with_columns_.find(package_id);
+    if (columns_it != packages_id_with_columns_.end()) {
+        const std::vector<float> &timestamps_s = columns_it->second.timestamps_s;
+        const uint64_t end_tick = std::min<uint64_t>(index_of_end_tick, timestamps_s.size());
+        column.assign(timestamps_s.begin() + std::min(index_of_begin_tick, end_tick), timestamps_s.begin() + end_tick);
+        return true;
+    }
+
+    const auto data_it = packages_id_with_data_.find(package_id);
+    if (data_it != packages_id_with_data_.end()) {
+        const uint64_t end_tick = std::min<uint64_t>(index_of_end_tick, data_it->second.size());
+        const uint64_t begin_tick = std::min(index_of_begin_tick, end_tick);
+        column.reserve(end_tick - begin_tick);
+        for (uint64_t i = begin_tick; i < end_tick; ++i) {
+            column.emplace_back(data_it->second[i].timestamp_s);
+        }
+        return true;
+    }
+
+    return packages_id_with_objects_.find(package_id) != packages_id_with_objects_.end();
+}
+
+}  // namespace slam_data_log
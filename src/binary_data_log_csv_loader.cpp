@@ -2,10 +2,20 @@
 #include "slam_log_reporter.h"
 #include "slam_operations.h"
 
+#include "algorithm"
+#include "array"
+#include "cerrno"
+#include "charconv"
+#include "cmath"
+#include "cstdlib"
 #include "cstring"
 #include "dirent.h"
 #include "filesystem"
 #include "iostream"
+#include "limits"
+#include "tuple"
+#include "thread"
+#include "type_traits"
 #include "unistd.h"
 #include "vector"
 
@@ -14,6 +24,110 @@ namespace slam_data_log {
 namespace {
     std::vector<std::string> kTimeStampSuffixList = {"_s", "_ns", "_us", "_ms", "[s]", "[ns]", "[us]", "[ms]"};
     std::vector<double> kTimeStampScaleList = {1.0, 1e-9, 1e-6, 1e-3, 1.0, 1e-9, 1e-6, 1e-3};
+
+    // Each chunk of csv file is encoded by one thread at a time. Chunks are split at line boundaries, so they are a little larger than this.
+    constexpr uint64_t kSizeOfCsvChunk = 2 * 1024 * 1024;
+
+    const char *FindCsvValueEnd(const char *value_begin, const char *line_end) {
+        const void *value_end = std::memchr(value_begin, ',', line_end - value_begin);
+        return value_end == nullptr ? line_end : static_cast<const char *>(value_end);
+    }
+
+    // Float holds the value exactly if the shortest decimal of float is the same value, e.g. 0.1 but not 0.123456789. Most values are
+    // the same in float, e.g. 0.5, so decimal is only printed for the others.
+    bool IsExactInFloat(const double value) {
+        if (!std::isfinite(value) || static_cast<double>(static_cast<float>(value)) == value) {
+            return true;
+        }
+        std::array<char, 32> chars;
+        const auto result = std::to_chars(chars.data(), chars.data() + chars.size(), static_cast<float>(value));
+        double value_of_float = 0.0;
+        std::from_chars(chars.data(), result.ptr, value_of_float);
+        return value_of_float == value;
+    }
+
+    // Range of values of one csv column. Ranges of parts of csv are merged into the range of all of them.
+    struct CsvColumnRange {
+        double min_value = INFINITY;
+        double max_value = -INFINITY;
+        bool is_integer = true;
+        bool is_exact_in_float = true;
+
+        void Add(const double value) {
+            min_value = std::min(min_value, value);
+            max_value = std::max(max_value, value);
+            is_integer = is_integer && std::isfinite(value) && value == std::trunc(value);
+            is_exact_in_float = is_exact_in_float && IsExactInFloat(value);
+        }
+
+        void Merge(const CsvColumnRange &range) {
+            min_value = std::min(min_value, range.min_value);
+            max_value = std::max(max_value, range.max_value);
+            is_integer = is_integer && range.is_integer;
+            is_exact_in_float = is_exact_in_float && range.is_exact_in_float;
+        }
+
+        // Integer types are tried from the narrowest one. Float is used if no value is added.
+        ItemType NarrowestType() const {
+            if (is_integer && min_value <= max_value) {
+                const std::vector<std::tuple<ItemType, double, double>> integer_types = {
+                    {ItemType::kUint8, 0.0, UINT8_MAX},
+                    {ItemType::kInt8, INT8_MIN, INT8_MAX},
+                    {ItemType::kUint16, 0.0, UINT16_MAX},
+                    {ItemType::kInt16, INT16_MIN, INT16_MAX},
+                    {ItemType::kUint32, 0.0, UINT32_MAX},
+                    {ItemType::kInt32, INT32_MIN, INT32_MAX},
+                };
+                for (const auto &[type, type_min_value, type_max_value]: integer_types) {
+                    if (min_value >= type_min_value && max_value <= type_max_value) {
+                        return type;
+                    }
+                }
+            }
+            return is_exact_in_float ? ItemType::kFloat : ItemType::kDouble;
+        }
+    };
+
+    // Integer value out of range is saturated, and NaN is recorded as 0. If checked, return false if value is changed by type.
+    template <typename T>
+    bool EncodeCsvValueAs(const double value, const bool is_checked, char *data_ptr) {
+        T typed_value = 0;
+        bool is_exact = true;
+        if constexpr (std::is_floating_point_v<T>) {
+            typed_value = static_cast<T>(value);
+            if constexpr (std::is_same_v<T, float>) {
+                is_exact = !is_checked || IsExactInFloat(value);
+            }
+        } else {
+            constexpr double kMinValue = static_cast<double>(std::numeric_limits<T>::lowest());
+            constexpr double kMaxValue = static_cast<double>(std::numeric_limits<T>::max());
+            if (value <= kMinValue) {
+                typed_value = std::numeric_limits<T>::lowest();
+            } else if (value >= kMaxValue) {
+                typed_value = std::numeric_limits<T>::max();
+            } else if (!std::isnan(value)) {
+                typed_value = static_cast<T>(value);
+            }
+            is_exact = !is_checked || static_cast<double>(typed_value) == value;
+        }
+        std::memcpy(data_ptr, &typed_value, sizeof(T));
+        return is_exact;
+    }
+
+    bool EncodeCsvValue(const double value, const ItemType type, const bool is_checked, char *data_ptr) {
+        switch (type) {
+            case ItemType::kUint8: return EncodeCsvValueAs<uint8_t>(value, is_checked, data_ptr);
+            case ItemType::kInt8: return EncodeCsvValueAs<int8_t>(value, is_checked, data_ptr);
+            case ItemType::kUint16: return EncodeCsvValueAs<uint16_t>(value, is_checked, data_ptr);
+            case ItemType::kInt16: return EncodeCsvValueAs<int16_t>(value, is_checked, data_ptr);
+            case ItemType::kUint32: return EncodeCsvValueAs<uint32_t>(value, is_checked, data_ptr);
+            case ItemType::kInt32: return EncodeCsvValueAs<int32_t>(value, is_checked, data_ptr);
+            case ItemType::kUint64: return EncodeCsvValueAs<uint64_t>(value, is_checked, data_ptr);
+            case ItemType::kInt64: return EncodeCsvValueAs<int64_t>(value, is_checked, data_ptr);
+            case ItemType::kDouble: return EncodeCsvValueAs<double>(value, is_checked, data_ptr);
+            default: return EncodeCsvValueAs<float>(value, is_checked, data_ptr);
+        }
+    }
 }  // namespace
 
 bool BinaryDataLog::ParseTimestampInCsvHeader(const std::string &csv_header_name, double &timestamp_scale) {
@@ -34,17 +148,292 @@ bool BinaryDataLog::ParseTimestampInCsvHeader(const std::string &csv_header_name
     return false;
 }
 
-bool BinaryDataLog::CreateLogFileByCsvFile(const std::string &csv_file_name, const std::string &log_file_name) {
+const char *BinaryDataLog::FindCsvLineEnd(const char *line_begin, const char *csv_end) {
+    const void *line_end = std::memchr(line_begin, '\n', csv_end - line_begin);
+    return line_end == nullptr ? csv_end : static_cast<const char *>(line_end);
+}
+
+bool BinaryDataLog::ParseCsvLine(const char *line_begin, const char *line_end, const uint32_t num_of_values, std::vector<double> &values) {
+    values.clear();
+    std::string value_str;
+    for (const char *value_begin = line_begin; values.size() <= num_of_values;) {
+        // Most values are parsed in place, and the following delimiter is found by the parser at the same time.
+        double value = 0.0;
+        const auto result = std::from_chars(value_begin, line_end, value);
+        if (result.ec == std::errc() && (result.ptr == line_end || *result.ptr == ',')) {
+            values.emplace_back(value);
+            BREAK_IF(result.ptr == line_end);
+            value_begin = result.ptr + 1;
+            continue;
+        }
+
+        // Others are parsed as std::stod does, after spaces are removed.
+        const char *value_end = FindCsvValueEnd(value_begin, line_end);
+        value_str.assign(value_begin, value_end);
+        value_str.erase(std::remove(value_str.begin(), value_str.end(), ' '), value_str.end());
+        if (!value_str.empty()) {
+            char *parsed_end = nullptr;
+            errno = 0;
+            value = std::strtod(value_str.c_str(), &parsed_end);
+            RETURN_FALSE_IF(parsed_end == value_str.c_str() || errno == ERANGE);
+            values.emplace_back(value);
+        }
+        BREAK_IF(value_end == line_end);
+        value_begin = value_end + 1;
+    }
+    return values.size() == num_of_values;
+}
+
+bool BinaryDataLog::FindFirstValidCsvLine(const char *lines_begin, const char *lines_end, const uint32_t num_of_values, std::vector<double> &values,
+                                          const char *&line_begin, uint32_t &num_of_skipped_lines) {
+    for (line_begin = lines_begin; line_begin < lines_end;) {
+        const char *line_end = FindCsvLineEnd(line_begin, lines_end);
+        BREAK_IF(line_end == line_begin);
+        const char *parsed_line_end = *(line_end - 1) == '\r' ? line_end - 1 : line_end;
+        if (ParseCsvLine(line_begin, parsed_line_end, num_of_values, values)) {
+            return true;
+        }
+        ++num_of_skipped_lines;
+        line_begin = line_end == lines_end ? lines_end : line_end + 1;
+    }
+    return false;
+}
+
+bool BinaryDataLog::InferTypesOfCsvColumns(const std::vector<std::string> &csv_header_items, const char *lines_begin, const char *lines_end,
+                                           const bool is_all_lines, const uint32_t num_of_threads, const CsvColumnTypes &csv_column_types,
+                                           std::vector<ItemType> &types_of_columns) {
+    const uint32_t num_of_values = static_cast<uint32_t>(csv_header_items.size());
+    // Later lines may leave the range of these lines, so double is used and lines are not scanned unless these are all lines of csv.
+    const char *scanned_lines_end = is_all_lines ? lines_end : lines_begin;
+
+    // Lines are split into one part per thread at line boundaries. Ranges of parts are merged in order, until the part with the first
+    // empty line.
+    const uint32_t num_of_parts = std::max(num_of_threads, 1u);
+    const uint64_t size_of_part = static_cast<uint64_t>(scanned_lines_end - lines_begin) / num_of_parts;
+    std::vector<const char *> bounds_of_parts = {lines_begin};
+    for (uint32_t i = 1; i < num_of_parts; ++i) {
+        const char *line_end = FindCsvLineEnd(std::max(bounds_of_parts.back(), lines_begin + i * size_of_part), scanned_lines_end);
+        bounds_of_parts.emplace_back(line_end == scanned_lines_end ? scanned_lines_end : line_end + 1);
+    }
+    bounds_of_parts.emplace_back(scanned_lines_end);
+    std::vector<std::vector<CsvColumnRange>> ranges_of_parts(num_of_parts, std::vector<CsvColumnRange>(num_of_values));
+    std::vector<uint8_t> is_part_ended_by_empty_line(num_of_parts, false);
+    const auto infer_ranges_of_part = [&](const uint32_t index_of_part) {
+        std::vector<double> double_values;
+        const char *part_end = bounds_of_parts[index_of_part + 1];
+        for (const char *line_begin = bounds_of_parts[index_of_part]; line_begin < part_end;) {
+            const char *line_end = FindCsvLineEnd(line_begin, part_end);
+            if (line_end == line_begin) {
+                is_part_ended_by_empty_line[index_of_part] = true;
+                break;
+            }
+            const char *parsed_line_begin = line_begin;
+            line_begin = line_end == part_end ? part_end : line_end + 1;
+            if (*(line_end - 1) == '\r') {
+                --line_end;
+            }
+            CONTINUE_IF(!ParseCsvLine(parsed_line_begin, line_end, num_of_values, double_values));
+            for (uint32_t i = 0; i < num_of_values; ++i) {
+                ranges_of_parts[index_of_part][i].Add(double_values[i]);
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < num_of_parts; ++i) {
+        threads.emplace_back(infer_ranges_of_part, i);
+    }
+    infer_ranges_of_part(0);
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    std::vector<CsvColumnRange> ranges_of_columns(num_of_values);
+    for (uint32_t i = 0; i < num_of_parts; ++i) {
+        for (uint32_t j = 0; j < num_of_values; ++j) {
+            ranges_of_columns[j].Merge(ranges_of_parts[i][j]);
+        }
+        BREAK_IF(is_part_ended_by_empty_line[i]);
+    }
+
+    types_of_columns.resize(num_of_values);
+    for (uint32_t i = 0; i < num_of_values; ++i) {
+        types_of_columns[i] = is_all_lines ? ranges_of_columns[i].NarrowestType() : ItemType::kDouble;
+        const auto it = csv_column_types.find(csv_header_items[i]);
+        CONTINUE_IF(it == csv_column_types.end());
+        if (it->second > ItemType::kDouble) {
+            ReportError("[DataLog] Type of csv column " << csv_header_items[i] << " can only be forced to scalar type.");
+            return false;
+        }
+        types_of_columns[i] = it->second;
+    }
+    return true;
+}
+
+bool BinaryDataLog::CreateLogFileByCsvFile(const std::string &csv_file_name, const std::string &log_file_name, const uint32_t num_of_threads,
+                                           const CsvColumnTypes &csv_column_types) {
     RETURN_FALSE_IF(csv_file_name.empty());
     RETURN_FALSE_IF(log_file_name.empty());
 
-    // Try to open csv file first.
-    std::ifstream csv_file_stream(csv_file_name.c_str());
-    if (!csv_file_stream.is_open()) {
+    // Try to open csv file first. It is mapped into memory, and all lines are parsed from mapped region directly.
+    BinaryDataLogMappedFile csv_file;
+    if (!csv_file.Open(csv_file_name)) {
         ReportError("[DataLog] Failed to open csv file: " + csv_file_name);
         return false;
     }
+    csv_file.AdviseSequentialAccess();
+    const char *csv_begin = reinterpret_cast<const char *>(csv_file.data());
+    const char *csv_end = csv_begin + csv_file.size();
+
+    // Create log file and register packages by header of csv file.
+    const char *csv_header_end = csv_file.size() == 0 ? csv_end : FindCsvLineEnd(csv_begin, csv_end);
+    const char *lines_begin = csv_header_end == csv_end ? csv_end : csv_header_end + 1;
+    BinaryDataLog log_recorder;
+    CsvRecordingPlan plan;
+    RETURN_FALSE_IF_FALSE(log_recorder.PrepareForRecordingCsv(std::string(csv_begin, csv_header_end), lines_begin, csv_end, true, num_of_threads,
+                                                              csv_file_name, log_file_name, csv_column_types, plan));
+
+    // Timestamp of the first valid line is the offset of all timestamps. Lines before it cannot be parsed.
+    std::vector<double> double_values;
+    uint32_t num_of_skipped_lines = 0;
+    uint32_t num_of_inexact_lines = 0;
+    const char *first_valid_line = nullptr;
+    if (FindFirstValidCsvLine(lines_begin, csv_end, plan.num_of_values, double_values, first_valid_line, num_of_skipped_lines)) {
+        plan.time_stamp_offset_s = double_values[plan.index_of_time_stamp];
+        // Iterate each line of csv file until an empty line, write data into log file. Lines which cannot be parsed are skipped.
+        log_recorder.RecordCsvLines(first_valid_line, csv_end, plan, std::max(num_of_threads, 1u), num_of_skipped_lines, num_of_inexact_lines);
+    }
+    if (num_of_skipped_lines > 0) {
+        ReportWarn("[DataLog] Skipped " << num_of_skipped_lines << " lines which cannot be parsed in csv file: " << csv_file_name);
+    }
+    if (num_of_inexact_lines > 0) {
+        ReportError("[DataLog] Values of " << num_of_inexact_lines << " lines are changed by forced types in csv file: " << csv_file_name);
+        return false;
+    }
+
+    return true;
+}
+
+bool BinaryDataLog::CreateLogFileByCsvStream(std::istream &csv_stream, const std::string &log_file_name, const CsvColumnTypes &csv_column_types) {
+    const auto read_bytes = [&csv_stream](char *bytes, const uint64_t size) -> int64_t {
+        csv_stream.read(bytes, static_cast<std::streamsize>(size));
+        return csv_stream.bad() ? -1 : static_cast<int64_t>(csv_stream.gcount());
+    };
+    return CreateLogFileByCsvReader(read_bytes, "stream", log_file_name, csv_column_types);
+}
+
+bool BinaryDataLog::CreateLogFileByCsvFileDescriptor(const int32_t file_descriptor, const std::string &log_file_name,
+                                                     const CsvColumnTypes &csv_column_types) {
+    // Pipe returns bytes as soon as they are written, which may be fewer than requested.
+    const auto read_bytes = [file_descriptor](char *bytes, const uint64_t size) -> int64_t {
+        int64_t size_of_read = 0;
+        do {
+            size_of_read = ::read(file_descriptor, bytes, size);
+        } while (size_of_read < 0 && errno == EINTR);
+        return size_of_read;
+    };
+    return CreateLogFileByCsvReader(read_bytes, "file descriptor " + std::to_string(file_descriptor), log_file_name, csv_column_types);
+}
 
+bool BinaryDataLog::CreateLogFileByCsvReader(const CsvBytesReader &read_bytes, const std::string &csv_name, const std::string &log_file_name,
+                                             const CsvColumnTypes &csv_column_types) {
+    RETURN_FALSE_IF(log_file_name.empty());
+
+    // Complete lines in buffer are recorded once they are read, then the last incomplete line is moved to the beginning of buffer.
+    std::vector<char> buffer(kSizeOfCsvChunk);
+    uint64_t size_of_buffered_bytes = 0;
+    // Footer index grows with number of frames, so it is not recorded. Log file is still indexed by scanning or sidecar index when loaded.
+    BinaryDataLog log_recorder;
+    log_recorder.record_footer_index() = false;
+    CsvRecordingPlan plan;
+    bool is_recording_prepared = false;
+    bool is_time_stamp_offset_valid = false;
+    bool is_ended_by_empty_line = false;
+    uint32_t num_of_skipped_lines = 0;
+    uint32_t num_of_inexact_lines = 0;
+    std::vector<double> double_values;
+    while (!is_ended_by_empty_line) {
+        if (size_of_buffered_bytes == buffer.size()) {
+            ReportError("[DataLog] Line is longer than " << buffer.size() << " bytes in csv " << csv_name);
+            return false;
+        }
+        const int64_t size_of_read = read_bytes(buffer.data() + size_of_buffered_bytes, buffer.size() - size_of_buffered_bytes);
+        if (size_of_read < 0) {
+            ReportError("[DataLog] Failed to read csv " << csv_name);
+            return false;
+        }
+        size_of_buffered_bytes += static_cast<uint64_t>(size_of_read);
+
+        // The last line of csv may have no line feed. Buffer is filled before recording, and if csv ends within it, all lines are seen and
+        // types of columns are inferred from them.
+        const bool is_end_of_csv = size_of_read == 0;
+        CONTINUE_IF(!is_recording_prepared && !is_end_of_csv && size_of_buffered_bytes < buffer.size());
+        const char *buffer_end = buffer.data() + size_of_buffered_bytes;
+        const void *last_line_feed = size_of_buffered_bytes == 0 ? nullptr : ::memrchr(buffer.data(), '\n', size_of_buffered_bytes);
+        CONTINUE_IF(last_line_feed == nullptr && !is_end_of_csv);
+        const char *lines_end = is_end_of_csv ? buffer_end : static_cast<const char *>(last_line_feed) + 1;
+        const char *line_begin = buffer.data();
+
+        // Create log file and register packages by header of csv.
+        if (!is_recording_prepared) {
+            const char *csv_header_end = FindCsvLineEnd(line_begin, lines_end);
+            const std::string csv_header(line_begin, csv_header_end);
+            line_begin = csv_header_end == lines_end ? lines_end : csv_header_end + 1;
+            RETURN_FALSE_IF_FALSE(log_recorder.PrepareForRecordingCsv(csv_header, line_begin, lines_end, is_end_of_csv, 1, csv_name, log_file_name,
+                                                                      csv_column_types, plan));
+            is_recording_prepared = true;
+        }
+
+        // Timestamp of the first valid line is the offset of all timestamps.
+        if (!is_time_stamp_offset_valid) {
+            is_time_stamp_offset_valid =
+                FindFirstValidCsvLine(line_begin, lines_end, plan.num_of_values, double_values, line_begin, num_of_skipped_lines);
+            is_ended_by_empty_line = !is_time_stamp_offset_valid && line_begin != lines_end;
+            if (is_time_stamp_offset_valid) {
+                plan.time_stamp_offset_s = double_values[plan.index_of_time_stamp];
+            }
+        }
+        if (is_time_stamp_offset_valid) {
+            is_ended_by_empty_line = !log_recorder.EncodeCsvLinesInStagingBuffer(line_begin, lines_end, plan, num_of_skipped_lines, num_of_inexact_lines,
+                                                                                 log_recorder.current_recorded_time_stamp_s_);
+            log_recorder.CommitStagedFramesToLogFile();
+        }
+        BREAK_IF(is_end_of_csv);
+
+        size_of_buffered_bytes = static_cast<uint64_t>(buffer_end - lines_end);
+        std::memmove(buffer.data(), lines_end, size_of_buffered_bytes);
+    }
+    if (num_of_skipped_lines > 0) {
+        ReportWarn("[DataLog] Skipped " << num_of_skipped_lines << " lines which cannot be parsed in csv " << csv_name);
+    }
+    if (num_of_inexact_lines > 0) {
+        ReportError("[DataLog] Values of " << num_of_inexact_lines << " lines are changed by forced types in csv " << csv_name);
+        return false;
+    }
+
+    return true;
+}
+
+bool BinaryDataLog::PrepareForRecordingCsv(const std::string &csv_header, const char *lines_begin, const char *lines_end, const bool is_all_lines,
+                                           const uint32_t num_of_threads, const std::string &csv_name, const std::string &log_file_name,
+                                           const CsvColumnTypes &csv_column_types, CsvRecordingPlan &plan) {
+    RETURN_FALSE_IF_FALSE(RegisterPackagesByCsvHeader(csv_header, lines_begin, lines_end, is_all_lines, num_of_threads, csv_name, 0, "default_package",
+                                                      csv_column_types, plan));
+
+    // Create log file.
+    if (!CreateLogFile(log_file_name)) {
+        ReportError("[DataLog] Failed to create log file: " + log_file_name);
+        return false;
+    }
+    if (!PrepareForRecording()) {
+        ReportError("[DataLog] Failed to prepare for recording: " + log_file_name);
+        return false;
+    }
+    return true;
+}
+
+bool BinaryDataLog::RegisterPackagesByCsvHeader(const std::string &csv_header, const char *lines_begin, const char *lines_end, const bool is_all_lines,
+                                                const uint32_t num_of_threads, const std::string &csv_name, const uint16_t base_package_id,
+                                                const std::string &default_package_name, const CsvColumnTypes &csv_column_types,
+                                                CsvRecordingPlan &plan) {
     // Prepare for loading csv file.
     // csv_header_items_map[package_name][item_name] = item_index;
     std::vector<std::string> csv_header_items;
@@ -54,8 +443,6 @@ bool BinaryDataLog::CreateLogFileByCsvFile(const std::string &csv_file_name, con
     std::string temp_str;
 
     // Print csv_header of csv file.
-    std::string csv_header;
-    std::getline(csv_file_stream, csv_header);
     std::istringstream csv_header_stream(csv_header);
     while (std::getline(csv_header_stream, temp_str, ',')) {
         temp_str.erase(std::remove(temp_str.begin(), temp_str.end(), ' '), temp_str.end());
@@ -73,37 +460,44 @@ bool BinaryDataLog::CreateLogFileByCsvFile(const std::string &csv_file_name, con
         }
     }
     if (time_stamp_index == -1) {
-        ReportError("[DataLog] Timestamp index not found in csv file: " + csv_file_name);
+        ReportError("[DataLog] Timestamp index not found in csv file: " + csv_name);
         return false;
     }
     ReportInfo("[DataLog] Time stamp index found in csv file: " << time_stamp_index << " [name][" << csv_header_items[time_stamp_index] << "] [scale]["
                                                                 << time_stamp_scale << "]");
 
+    // Infer types of scalar columns. Columns gathered into vector3 or pose are recorded in float.
+    std::vector<ItemType> types_of_columns;
+    RETURN_FALSE_IF_FALSE(InferTypesOfCsvColumns(csv_header_items, lines_begin, lines_end, is_all_lines, num_of_threads, csv_column_types,
+                                                 types_of_columns));
+    std::vector<ItemType> recorded_types_of_columns(csv_header_items.size(), ItemType::kFloat);
+    const auto is_any_column_type_forced = [&](const std::vector<std::pair<std::string, int32_t>> &items, const int32_t index, const int32_t size) {
+        for (int32_t i = index; i < index + size; ++i) {
+            if (csv_column_types.count(csv_header_items[items[i].second]) > 0) {
+                return true;
+            }
+        }
+        return false;
+    };
+
     // Parse csv header items into csv_header_items_map.
     for (uint32_t i = 0; i < csv_header_items.size(); i++) {
         const std::string temp_package_name = csv_header_items[i].substr(0, csv_header_items[i].find('/'));
         const std::string item_name = csv_header_items[i].substr(csv_header_items[i].find('/') + 1);
-        const std::string package_name = temp_package_name.size() == csv_header_items[i].size() ? "default_package" : temp_package_name;
+        const std::string package_name = temp_package_name.size() == csv_header_items[i].size() ? default_package_name : temp_package_name;
         CONTINUE_IF(item_name.empty());
         CONTINUE_IF(static_cast<int32_t>(i) == time_stamp_index);
         csv_header_items_map[package_name].emplace_back(std::make_pair(item_name, i));
     }
     ReportInfo("[DataLog] Succeed to parse csv header items into binlog header:");
     for (const auto &package: csv_header_items_map) {
-        ReportInfo("[DataLog] >> Package [name][" << package.first << "] [id][" << package.second.begin()->second << "]");
+        ReportInfo("[DataLog] >> Package [name][" << package.first << "] [id][" << base_package_id + package.second.begin()->second << "]");
         for (const auto &item: package.second) {
             ReportInfo("[DataLog]    - Item [name][" << item.first << "] [col index][" << item.second << "]");
         }
     }
 
-    // Create log file.
-    BinaryDataLog log_recorder;
-    if (!log_recorder.CreateLogFile(log_file_name)) {
-        ReportError("[DataLog] Failed to create log file: " + log_file_name);
-        return false;
-    }
-
-    // Register packages to log recorder.
+    // Register packages to log recorder. Package id is the column index of its first item, offset by base package id.
     std::vector<std::string> items_name_in_one_package;
     for (const auto &package: csv_header_items_map) {
         const auto &items = package.second;
@@ -113,12 +507,12 @@ bool BinaryDataLog::CreateLogFileByCsvFile(const std::string &csv_file_name, con
         }
 
         std::unique_ptr<PackageInfo> package_ptr = std::make_unique<PackageInfo>();
-        package_ptr->id = items.begin()->second;
+        package_ptr->id = base_package_id + items.begin()->second;
         package_ptr->name = package.first;
 
         for (int32_t i = 0; i < static_cast<int32_t>(items.size()); i++) {
             using namespace slam_utility;
-            if (i < static_cast<int32_t>(items.size()) - 6) {
+            if (i < static_cast<int32_t>(items.size()) - 6 && !is_any_column_type_forced(items, i, 7)) {
                 if (SlamOperation::IsEndWith(items_name_in_one_package, i, std::vector<std::string> {"x", "y", "z", "w", "x", "y", "z"})) {
                     CONTINUE_IF(!SlamOperation::IsContained(items_name_in_one_package, i, std::vector<std::string> {"p_"}));
                     CONTINUE_IF(!SlamOperation::IsContained(items_name_in_one_package, i + 3, std::vector<std::string> {"q_"}));
@@ -137,7 +531,7 @@ bool BinaryDataLog::CreateLogFileByCsvFile(const std::string &csv_file_name, con
                     continue;
                 }
             }
-            if (i < static_cast<int32_t>(items.size()) - 2) {
+            if (i < static_cast<int32_t>(items.size()) - 2 && !is_any_column_type_forced(items, i, 3)) {
                 if (SlamOperation::IsEndWith(items_name_in_one_package, i, std::vector<std::string> {"x", "y", "z"})) {
                     std::string vector3_item_name = items[i].first;
                     if (vector3_item_name.size() <= 2) {
@@ -152,58 +546,133 @@ bool BinaryDataLog::CreateLogFileByCsvFile(const std::string &csv_file_name, con
                     continue;
                 }
             }
-            package_ptr->items.emplace_back(PackageItemInfo {.type = ItemType::kFloat, .name = items[i].first});
+            recorded_types_of_columns[items[i].second] = types_of_columns[items[i].second];
+            package_ptr->items.emplace_back(PackageItemInfo {.type = types_of_columns[items[i].second], .name = items[i].first});
         }
-        if (!log_recorder.RegisterPackage(package_ptr)) {
+        if (!RegisterPackage(package_ptr)) {
             ReportError("[DataLog] Failed to register package: " + package.first);
             return false;
         }
     }
-    if (!log_recorder.PrepareForRecording()) {
-        ReportError("[DataLog] Failed to prepare for recording: " + log_file_name);
-        return false;
-    }
 
-    // Iterate each line of csv_file_stream, write data into log file.
-    std::string csv_line;
-    std::vector<double> double_values;
-    std::vector<float> float_values;
-    std::vector<float> package_float_values;
-    double time_stamp_offset_s = 0.0;
-    bool is_time_stamp_offset_valid = false;
-    while (std::getline(csv_file_stream, csv_line) && !csv_line.empty()) {
-        std::istringstream csv_line_stream(csv_line);
-        std::string temp_str;
-        double_values.clear();
-        while (std::getline(csv_line_stream, temp_str, ',')) {
-            temp_str.erase(std::remove(temp_str.begin(), temp_str.end(), ' '), temp_str.end());
-            CONTINUE_IF(temp_str.empty());
-            double_values.emplace_back(std::stod(temp_str));
-        }
-        CONTINUE_IF(double_values.size() != csv_header_items.size());
-        if (!is_time_stamp_offset_valid) {
-            time_stamp_offset_s = double_values[time_stamp_index];
-            is_time_stamp_offset_valid = true;
+    // Plan of gathering columns into each package is decided once, then used for all lines.
+    plan = CsvRecordingPlan();
+    plan.num_of_values = static_cast<uint32_t>(csv_header_items.size());
+    plan.index_of_time_stamp = static_cast<uint32_t>(time_stamp_index);
+    plan.time_stamp_scale = time_stamp_scale;
+    for (const auto &package: csv_header_items_map) {
+        CsvPackageGatherPlan &gather_plan = plan.gather_plans.emplace_back();
+        gather_plan.package_id = base_package_id + package.second.begin()->second;
+        for (const auto &item: package.second) {
+            gather_plan.indices_of_columns.emplace_back(item.second);
+            gather_plan.types_of_columns.emplace_back(recorded_types_of_columns[item.second]);
+            gather_plan.is_type_forced_of_columns.emplace_back(csv_column_types.count(csv_header_items[item.second]) > 0);
+            gather_plan.size_of_data += item_type_sizes[static_cast<uint32_t>(recorded_types_of_columns[item.second])];
         }
+    }
+    return true;
+}
 
-        float_values.clear();
-        for (const auto &value: double_values) {
-            float_values.emplace_back(static_cast<float>(value));
-        }
+void BinaryDataLog::RecordCsvLines(const char *lines_begin, const char *lines_end, const CsvRecordingPlan &plan, const uint32_t num_of_threads,
+                                   uint32_t &num_of_skipped_lines, uint32_t &num_of_inexact_lines) {
+    // Chunks are taken by threads in file order, and committed in the same order. Lines after the first empty line are not recorded.
+    std::mutex chunk_mutex;
+    std::condition_variable chunk_committed_signal;
+    const char *chunk_begin_to_take = lines_begin;
+    uint64_t num_of_taken_chunks = 0;
+    uint64_t num_of_committed_chunks = 0;
+    uint64_t index_of_last_chunk = UINT64_MAX;
 
-        for (const auto &package: csv_header_items_map) {
-            const uint16_t package_id = package.second.begin()->second;
-            package_float_values.clear();
-            for (const auto &item : package.second) {
-                package_float_values.emplace_back(float_values[item.second]);
+    const auto encode_and_commit_chunks = [&]() {
+        while (true) {
+            const char *chunk_begin = nullptr;
+            const char *chunk_end = nullptr;
+            uint64_t index_of_chunk = 0;
+            {
+                std::unique_lock<std::mutex> lock(chunk_mutex);
+                BREAK_IF(chunk_begin_to_take == lines_end || num_of_taken_chunks > index_of_last_chunk);
+                chunk_begin = chunk_begin_to_take;
+                const bool is_last_chunk = static_cast<uint64_t>(lines_end - chunk_begin) <= kSizeOfCsvChunk;
+                chunk_end = is_last_chunk ? lines_end : FindCsvLineEnd(chunk_begin + kSizeOfCsvChunk, lines_end);
+                chunk_end = chunk_end == lines_end ? lines_end : chunk_end + 1;
+                chunk_begin_to_take = chunk_end;
+                index_of_chunk = num_of_taken_chunks++;
+            }
+
+            // Frames of this chunk are staged in staging buffer of this thread, until all chunks before it are committed.
+            uint32_t num_of_skipped_lines_in_chunk = 0;
+            uint32_t num_of_inexact_lines_in_chunk = 0;
+            float last_time_stamp_s = 0.0f;
+            const bool is_ended_by_empty_line = !EncodeCsvLinesInStagingBuffer(chunk_begin, chunk_end, plan, num_of_skipped_lines_in_chunk,
+                                                                               num_of_inexact_lines_in_chunk, last_time_stamp_s);
+            std::unique_lock<std::mutex> lock(chunk_mutex);
+            if (is_ended_by_empty_line) {
+                index_of_last_chunk = std::min(index_of_last_chunk, index_of_chunk);
+            }
+            chunk_committed_signal.wait(lock, [&]() { return num_of_committed_chunks == index_of_chunk; });
+            if (index_of_chunk <= index_of_last_chunk) {
+                lock.unlock();
+                CommitStagedFramesToLogFile();
+                current_recorded_time_stamp_s_ = last_time_stamp_s;
+                lock.lock();
+                num_of_skipped_lines += num_of_skipped_lines_in_chunk;
+                num_of_inexact_lines += num_of_inexact_lines_in_chunk;
+            } else {
+                StagingBufferOfThisThread().size = 0;
             }
-            const float time_stamp_s = static_cast<float>((double_values[time_stamp_index] - time_stamp_offset_s) * time_stamp_scale);
-            log_recorder.RecordPackage(package_id, reinterpret_cast<const char *>(package_float_values.data()), time_stamp_s);
-            log_recorder.current_recorded_time_stamp_s() = time_stamp_s;
+            ++num_of_committed_chunks;
+            chunk_committed_signal.notify_all();
         }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < num_of_threads; ++i) {
+        threads.emplace_back(encode_and_commit_chunks);
+    }
+    encode_and_commit_chunks();
+    for (auto &thread: threads) {
+        thread.join();
     }
+}
+
+bool BinaryDataLog::EncodeCsvLinesInStagingBuffer(const char *lines_begin, const char *lines_end, const CsvRecordingPlan &plan,
+                                                  uint32_t &num_of_skipped_lines, uint32_t &num_of_inexact_lines, float &last_time_stamp_s) {
+    std::vector<double> double_values;
+    for (const char *line_begin = lines_begin; line_begin < lines_end;) {
+        const char *line_end = FindCsvLineEnd(line_begin, lines_end);
+        RETURN_FALSE_IF(line_end == line_begin);
+        const char *parsed_line_begin = line_begin;
+        line_begin = line_end == lines_end ? lines_end : line_end + 1;
+        if (*(line_end - 1) == '\r') {
+            --line_end;
+        }
+        if (!ParseCsvLine(parsed_line_begin, line_end, plan.num_of_values, double_values)) {
+            ++num_of_skipped_lines;
+            continue;
+        }
 
+        last_time_stamp_s = static_cast<float>((double_values[plan.index_of_time_stamp] - plan.time_stamp_offset_s) * plan.time_stamp_scale);
+        if (!EncodeCsvValuesInStagingBuffer(plan, double_values.data(), last_time_stamp_s)) {
+            ++num_of_inexact_lines;
+        }
+    }
     return true;
 }
 
+bool BinaryDataLog::EncodeCsvValuesInStagingBuffer(const CsvRecordingPlan &plan, const double *values, const float time_stamp_s) {
+    // Each package is encoded as a frame, the same as recording it by RecordPackage().
+    bool is_exact = true;
+    for (const auto &gather_plan: plan.gather_plans) {
+        const uint32_t index_of_frame_in_staging_buffer = StagingBufferOfThisThread().size;
+        char *data_ptr = BeginFrameInStagingBuffer(gather_plan.package_id, time_stamp_s, gather_plan.size_of_data);
+        for (uint32_t i = 0; i < gather_plan.indices_of_columns.size(); ++i) {
+            const ItemType type = gather_plan.types_of_columns[i];
+            is_exact &= EncodeCsvValue(values[gather_plan.indices_of_columns[i]], type, gather_plan.is_type_forced_of_columns[i], data_ptr);
+            data_ptr += item_type_sizes[static_cast<uint32_t>(type)];
+        }
+        SealFrameInStagingBuffer(index_of_frame_in_staging_buffer);
+    }
+    return is_exact;
+}
+
 }  // namespace slam_data_log
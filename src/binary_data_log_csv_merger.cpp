@@ -0,0 +1,192 @@
+#include "binary_data_log.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "algorithm"
+#include "deque"
+#include "filesystem"
+#include "queue"
+
+namespace slam_data_log {
+
+namespace {
+    // Lines of each csv file are parsed into batches, and only a few batches are queued, so memory is bounded no matter how large csv files are.
+    constexpr uint32_t kNumOfCsvRowsInBatch = 4096;
+    constexpr uint32_t kMaxNumOfCsvBatchesInQueue = 4;
+    // Staged frames are committed into log file once they are more than this.
+    constexpr uint32_t kSizeOfMergedFramesToCommit = 2 * 1024 * 1024;
+}  // namespace
+
+struct BinaryDataLog::CsvFileToMerge {
+    std::string name;
+    BinaryDataLogMappedFile mapped_file;
+    CsvRecordingPlan plan;
+    const char *lines_begin = nullptr;
+    const char *lines_end = nullptr;
+    uint32_t num_of_skipped_lines = 0;
+    uint32_t num_of_inexact_lines = 0;
+
+    // Batches of parsed lines, each line has 'plan.num_of_values' values. Written by parser thread, read by merger.
+    std::mutex batches_mutex;
+    std::condition_variable batches_signal;
+    std::deque<std::vector<double>> batches;
+    bool is_finished = false;
+    std::thread parser_thread;
+
+    // Line being merged.
+    std::vector<double> current_batch;
+    uint32_t index_of_current_row = 0;
+
+    void ParseLinesIntoBatches() {
+        std::vector<double> batch;
+        std::vector<double> double_values;
+        const char *released_end = reinterpret_cast<const char *>(mapped_file.data());
+        for (const char *line_begin = lines_begin; line_begin < lines_end;) {
+            const char *line_end = FindCsvLineEnd(line_begin, lines_end);
+            BREAK_IF(line_end == line_begin);
+            const char *parsed_line_begin = line_begin;
+            line_begin = line_end == lines_end ? lines_end : line_end + 1;
+            if (*(line_end - 1) == '\r') {
+                --line_end;
+            }
+            if (!ParseCsvLine(parsed_line_begin, line_end, plan.num_of_values, double_values)) {
+                ++num_of_skipped_lines;
+                continue;
+            }
+            batch.insert(batch.end(), double_values.begin(), double_values.end());
+            CONTINUE_IF(batch.size() < static_cast<uint64_t>(kNumOfCsvRowsInBatch) * plan.num_of_values);
+
+            // Pages of parsed lines will never be read again.
+            PushBatch(batch);
+            mapped_file.ReleasePages(released_end - reinterpret_cast<const char *>(mapped_file.data()), line_begin - released_end);
+            released_end = line_begin;
+        }
+        PushBatch(batch);
+        std::unique_lock<std::mutex> lock(batches_mutex);
+        is_finished = true;
+        batches_signal.notify_all();
+    }
+
+    void PushBatch(std::vector<double> &batch) {
+        RETURN_IF(batch.empty());
+        std::unique_lock<std::mutex> lock(batches_mutex);
+        batches_signal.wait(lock, [this]() { return batches.size() < kMaxNumOfCsvBatchesInQueue; });
+        batches.emplace_back(std::move(batch));
+        batch.clear();
+        batches_signal.notify_all();
+    }
+
+    // Return nullptr if all lines are merged.
+    const double *CurrentRow() {
+        if (index_of_current_row * plan.num_of_values >= current_batch.size()) {
+            std::unique_lock<std::mutex> lock(batches_mutex);
+            batches_signal.wait(lock, [this]() { return !batches.empty() || is_finished; });
+            if (batches.empty()) {
+                return nullptr;
+            }
+            current_batch = std::move(batches.front());
+            batches.pop_front();
+            index_of_current_row = 0;
+            batches_signal.notify_all();
+        }
+        return current_batch.data() + static_cast<uint64_t>(index_of_current_row) * plan.num_of_values;
+    }
+
+    double AbsoluteTimeStampOfRow(const double *row) const { return row[plan.index_of_time_stamp] * plan.time_stamp_scale; }
+};
+
+bool BinaryDataLog::CreateLogFileByCsvFiles(const std::vector<std::string> &csv_file_names, const std::string &log_file_name,
+                                            const CsvColumnTypes &csv_column_types) {
+    RETURN_FALSE_IF(csv_file_names.empty());
+    RETURN_FALSE_IF(log_file_name.empty());
+
+    // Register packages of all csv files into one log file. Package ids of each csv file follow those of csv files before it.
+    BinaryDataLog log_recorder;
+    std::vector<std::unique_ptr<CsvFileToMerge>> csv_files;
+    uint32_t base_package_id = 0;
+    const uint32_t num_of_threads_for_inferring = std::max(std::thread::hardware_concurrency(), 1u);
+    for (const auto &csv_file_name: csv_file_names) {
+        auto &csv_file = csv_files.emplace_back(std::make_unique<CsvFileToMerge>());
+        csv_file->name = csv_file_name;
+        if (!csv_file->mapped_file.Open(csv_file_name)) {
+            ReportError("[DataLog] Failed to open csv file: " + csv_file_name);
+            return false;
+        }
+        csv_file->mapped_file.AdviseSequentialAccess();
+        const char *csv_begin = reinterpret_cast<const char *>(csv_file->mapped_file.data());
+        const char *csv_end = csv_begin + csv_file->mapped_file.size();
+        const char *csv_header_end = csv_file->mapped_file.size() == 0 ? csv_end : FindCsvLineEnd(csv_begin, csv_end);
+        csv_file->lines_begin = csv_header_end == csv_end ? csv_end : csv_header_end + 1;
+        csv_file->lines_end = csv_end;
+
+        const std::string csv_header(csv_begin, csv_header_end);
+        const std::string default_package_name = std::filesystem::path(csv_file_name).stem().string();
+        RETURN_FALSE_IF_FALSE(log_recorder.RegisterPackagesByCsvHeader(csv_header, csv_file->lines_begin, csv_file->lines_end, true,
+                                                                       num_of_threads_for_inferring, csv_file_name, static_cast<uint16_t>(base_package_id),
+                                                                       default_package_name, csv_column_types, csv_file->plan));
+        base_package_id += csv_file->plan.num_of_values;
+        if (base_package_id >= kFooterIndexPackageId) {
+            ReportError("[DataLog] Too many columns in csv files to be merged, package ids are out of range.");
+            return false;
+        }
+    }
+    if (!log_recorder.CreateLogFile(log_file_name)) {
+        ReportError("[DataLog] Failed to create log file: " + log_file_name);
+        return false;
+    }
+    if (!log_recorder.PrepareForRecording()) {
+        ReportError("[DataLog] Failed to prepare for recording: " + log_file_name);
+        return false;
+    }
+
+    // Each csv file is parsed by its own thread, until the first empty line.
+    for (auto &csv_file: csv_files) {
+        csv_file->parser_thread = std::thread(&CsvFileToMerge::ParseLinesIntoBatches, csv_file.get());
+    }
+
+    // Lines are merged by absolute timestamp. Lines with the same timestamp are ordered by csv files. The earliest timestamp of all csv
+    // files is the offset of all timestamps.
+    using TimeStampWithFileIndex = std::pair<double, uint32_t>;
+    std::priority_queue<TimeStampWithFileIndex, std::vector<TimeStampWithFileIndex>, std::greater<TimeStampWithFileIndex>> heads_of_csv_files;
+    for (uint32_t i = 0; i < csv_files.size(); ++i) {
+        const double *row = csv_files[i]->CurrentRow();
+        CONTINUE_IF(row == nullptr);
+        heads_of_csv_files.emplace(csv_files[i]->AbsoluteTimeStampOfRow(row), i);
+    }
+    const double time_stamp_offset_s = heads_of_csv_files.empty() ? 0.0 : heads_of_csv_files.top().first;
+    while (!heads_of_csv_files.empty()) {
+        const auto [absolute_time_stamp_s, index_of_file] = heads_of_csv_files.top();
+        heads_of_csv_files.pop();
+        CsvFileToMerge &csv_file = *csv_files[index_of_file];
+        const float time_stamp_s = static_cast<float>(absolute_time_stamp_s - time_stamp_offset_s);
+        if (!log_recorder.EncodeCsvValuesInStagingBuffer(csv_file.plan, csv_file.CurrentRow(), time_stamp_s)) {
+            ++csv_file.num_of_inexact_lines;
+        }
+        log_recorder.current_recorded_time_stamp_s_ = time_stamp_s;
+        if (StagingBufferOfThisThread().size > kSizeOfMergedFramesToCommit) {
+            log_recorder.CommitStagedFramesToLogFile();
+        }
+
+        ++csv_file.index_of_current_row;
+        const double *next_row = csv_file.CurrentRow();
+        CONTINUE_IF(next_row == nullptr);
+        heads_of_csv_files.emplace(csv_file.AbsoluteTimeStampOfRow(next_row), index_of_file);
+    }
+    log_recorder.CommitStagedFramesToLogFile();
+
+    bool is_exact = true;
+    for (auto &csv_file: csv_files) {
+        csv_file->parser_thread.join();
+        if (csv_file->num_of_skipped_lines > 0) {
+            ReportWarn("[DataLog] Skipped " << csv_file->num_of_skipped_lines << " lines which cannot be parsed in csv file: " << csv_file->name);
+        }
+        if (csv_file->num_of_inexact_lines > 0) {
+            ReportError("[DataLog] Values of " << csv_file->num_of_inexact_lines << " lines are changed by forced types in csv file: " << csv_file->name);
+            is_exact = false;
+        }
+    }
+
+    return is_exact;
+}
+
+}  // namespace slam_data_log
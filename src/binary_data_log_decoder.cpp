@@ -3,222 +3,426 @@
 #include "slam_memory.h"
 #include "slam_operations.h"
 
+#include "cstring"
+#include "limits"
+
 namespace slam_data_log {
 
-uint8_t *BinaryDataLog::LoadBinaryDataFromLogFile(uint64_t index_in_file, uint32_t size) {
-    if (file_r_ptr_ == nullptr) {
-        ReportError("[DataLog] file_r_ptr_ is nullptr.");
+uint8_t *BinaryDataLog::LoadBinaryDataFromLogFile(uint64_t index_in_file, uint32_t size) const {
+    if (!mapped_file_r_.IsOpen()) {
+        ReportError("[DataLog] Log file is not loaded.");
+        return nullptr;
+    }
+    if (!mapped_file_r_.IsInside(index_in_file, size)) {
+        ReportError("[DataLog] Binary data [" << index_in_file << ", " << index_in_file + size << ") is out of log file.");
         return nullptr;
     }
 
     uint8_t *buff = new uint8_t[size];
-    file_r_ptr_->seekg(index_in_file, std::ios::beg);
-    file_r_ptr_->read(reinterpret_cast<char *>(buff), size);
+    std::memcpy(buff, mapped_file_r_.data() + index_in_file, size);
 
     return buff;
 }
 
+BinaryDataView BinaryDataLog::LoadBinaryDataViewFromLogFile(uint64_t index_in_file, uint32_t size) const {
+    BinaryDataView view = payload_cache_.Find(index_in_file, size);
+    if (!view.empty() || size == 0) {
+        return view;
+    }
+
+    view = CopyBinaryDataViewFromLogFile(index_in_file, size);
+    if (!view.empty()) {
+        payload_cache_.Insert(index_in_file, view);
+    }
+    return view;
+}
+
+BinaryDataView BinaryDataLog::CopyBinaryDataViewFromLogFile(uint64_t index_in_file, uint32_t size) const {
+    if (!mapped_file_r_.IsOpen()) {
+        ReportError("[DataLog] Log file is not loaded.");
+        return BinaryDataView();
+    }
+    if (!mapped_file_r_.IsInside(index_in_file, size)) {
+        ReportError("[DataLog] Binary data [" << index_in_file << ", " << index_in_file + size << ") is out of log file.");
+        return BinaryDataView();
+    }
+
+    const uint8_t *data_ptr = mapped_file_r_.data() + index_in_file;
+    return BinaryDataView(std::make_shared<const std::vector<uint8_t>>(data_ptr, data_ptr + size));
+}
+
+bool BinaryDataLog::LoadBinaryDataViewsFromLogFile(const std::vector<std::pair<uint64_t, uint32_t>> &requests,
+                                                   std::vector<BinaryDataView> &views) const {
+    views.clear();
+    views.resize(requests.size());
+
+    // Sizes of requests are quite different, so each thread takes the next request once it is free.
+    std::atomic<uint64_t> index_of_next_request = 0;
+    std::atomic<bool> is_all_loaded = true;
+    const auto load_requests = [&]() {
+        for (uint64_t i = index_of_next_request++; i < requests.size(); i = index_of_next_request++) {
+            views[i] = LoadBinaryDataViewFromLogFile(requests[i].first, requests[i].second);
+            if (views[i].empty() && requests[i].second > 0) {
+                is_all_loaded = false;
+            }
+        }
+    };
+    const uint64_t num_of_threads = std::max<uint64_t>(1, std::min<uint64_t>(num_of_threads_for_loading_, requests.size()));
+    std::vector<std::thread> threads;
+    for (uint64_t i = 1; i < num_of_threads; ++i) {
+        threads.emplace_back(load_requests);
+    }
+    load_requests();
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    return is_all_loaded;
+}
+
+const std::unique_ptr<std::ifstream> &BinaryDataLog::file_r_ptr() const {
+    file_r_ptr_.reset();
+    if (mapped_file_r_.IsOpen()) {
+        file_r_ptr_ = std::make_unique<std::ifstream>(mapped_file_r_.file_name(), std::ios::in | std::ios::binary);
+    }
+    return file_r_ptr_;
+}
+
 bool BinaryDataLog::LoadLogFile(const std::string &log_file_name, bool load_dynamic_package_full_data) {
-    // If last log file is not closed, close it.
-    if (file_r_ptr_ != nullptr) {
-        file_r_ptr_->close();
-        file_r_ptr_.reset();
+    // Prefetcher reads mapped log file and loaded ticks, which are replaced here.
+    StopPrefetching();
+    // Try to map log file. If last log file is not closed, it will be closed.
+    if (!mapped_file_r_.Open(log_file_name)) {
+        ReportError("[DataLog] Cannot open log file : " << log_file_name);
+        return false;
+    }
+    // Binary data cached and pyramids built from last log file are useless.
+    payload_cache_.Clear();
+    packages_id_with_item_pyramids_.clear();
+
+    // Check header.
+    RETURN_FALSE_IF_FALSE(CheckLogFileHeader());
+    // Load all registered packages information.
+    RETURN_FALSE_IF_FALSE(LoadRegisteredPackagesFromFileHead());
+    SelectPackagesToLoad();
+    // Load all data. If sidecar index is valid, log file is not scanned.
+    packages_id_with_data_.clear();
+    packages_id_with_columns_.clear();
+    timestamp_s_range_of_loaded_log_ = std::make_pair(INFINITY, -INFINITY);
+    if (!use_sidecar_index_ || !LoadSidecarIndex(load_dynamic_package_full_data, true)) {
+        LoadAllPackages(load_dynamic_package_full_data, true);
+        if (use_sidecar_index_) {
+            SaveSidecarIndex();
+        }
     }
+    SortLoadedPackagesByTimestamp();
 
-    // Try to create new log file.
-    file_r_ptr_ = std::make_unique<std::ifstream>(log_file_name, std::ios::in | std::ios::binary);
-    if (!file_r_ptr_->is_open()) {
+    return true;
+}
+
+bool BinaryDataLog::LoadLogFileIndex(const std::string &log_file_name) {
+    // Prefetcher reads mapped log file and loaded ticks, which are replaced here.
+    StopPrefetching();
+    // Try to map log file. If last log file is not closed, it will be closed.
+    if (!mapped_file_r_.Open(log_file_name)) {
         ReportError("[DataLog] Cannot open log file : " << log_file_name);
         return false;
     }
+    // Binary data cached and pyramids built from last log file are useless.
+    payload_cache_.Clear();
+    packages_id_with_item_pyramids_.clear();
 
     // Check header.
     RETURN_FALSE_IF_FALSE(CheckLogFileHeader());
     // Load all registered packages information.
     RETURN_FALSE_IF_FALSE(LoadRegisteredPackagesFromFileHead());
-    // Load all data.
+    SelectPackagesToLoad();
+
+    // Load index of all data from footer index, or from sidecar index if footer index is missing. Only load the location of all data.
+    packages_id_with_data_.clear();
+    packages_id_with_columns_.clear();
     timestamp_s_range_of_loaded_log_ = std::make_pair(INFINITY, -INFINITY);
-    while (!file_r_ptr_->eof()) {
-        // Break only when it is end or out of file.
-        const uint64_t index_in_file_now = file_r_ptr_->tellg();
-        file_r_ptr_->seekg(0, std::ios::end);
-        const uint64_t index_in_file_end = file_r_ptr_->tellg();
-        if (index_in_file_now >= index_in_file_end) {
-            break;
-        } else {
-            file_r_ptr_->seekg(index_in_file_now, std::ios::beg);
+    if (!LoadFooterIndex() && (!use_sidecar_index_ || !LoadSidecarIndex(false, false))) {
+        // Footer index is missing if log file is truncated or still being recorded, so scan the whole log file instead.
+        ReportWarn("[DataLog] Footer index of log file is not valid, scan the whole log file : " << log_file_name);
+        LoadAllPackages(false, false);
+        if (use_sidecar_index_) {
+            SaveSidecarIndex();
         }
+    }
+    SortLoadedPackagesByTimestamp();
+
+    return true;
+}
+
+void BinaryDataLog::LoadAllPackages(bool load_dynamic_package_full_data, bool load_static_package_full_data) {
+    if (num_of_threads_for_loading_ > 1) {
+        LoadAllPackagesInParallel(load_dynamic_package_full_data, load_static_package_full_data);
+        return;
+    }
 
+    DecodedPackages decoded_packages;
+    LoadPackagesInRange(index_in_file_of_content_, mapped_file_r_.size(), load_dynamic_package_full_data, load_static_package_full_data,
+                        decoded_packages);
+    MergeDecodedPackages(decoded_packages);
+}
+
+uint64_t BinaryDataLog::LoadPackagesInRange(uint64_t index_in_file, const uint64_t end_index_in_file, bool load_dynamic_package_full_data,
+                                            bool load_static_package_full_data, DecodedPackages &decoded_packages) const {
+    // Load all packages beginning in [index_in_file, end_index_in_file). The last one may end after this range.
+    while (index_in_file < end_index_in_file) {
         // If one package is broken in this file, skip it and continue loading.
-        LoadOnePackage(load_dynamic_package_full_data);
+        LoadOnePackage(index_in_file, decoded_packages, load_dynamic_package_full_data, load_static_package_full_data);
     }
+    return index_in_file;
+}
 
-    // Reopen this log file. If not do this, the belowing 'LoadBinaryDataFromLogFile' will make error.
-    file_r_ptr_->close();
-    file_r_ptr_ = std::make_unique<std::ifstream>(log_file_name, std::ios::in | std::ios::binary);
-    return true;
+void BinaryDataLog::MergeDecodedPackages(DecodedPackages &decoded_packages) {
+    for (auto &[package_id, package_data]: decoded_packages.packages_id_with_data) {
+        auto &packages_to_merge = packages_id_with_data_[package_id];
+        if (packages_to_merge.empty()) {
+            packages_to_merge = std::move(package_data);
+        } else {
+            packages_to_merge.insert(packages_to_merge.end(), std::make_move_iterator(package_data.begin()), std::make_move_iterator(package_data.end()));
+        }
+    }
+    decoded_packages.packages_id_with_data.clear();
+
+    for (auto &[package_id, package_columns]: decoded_packages.packages_id_with_columns) {
+        auto &columns_to_merge = packages_id_with_columns_[package_id];
+        if (columns_to_merge.timestamps_s.empty()) {
+            columns_to_merge = std::move(package_columns);
+        } else {
+            columns_to_merge.timestamps_s.insert(columns_to_merge.timestamps_s.end(), package_columns.timestamps_s.begin(), package_columns.timestamps_s.end());
+            columns_to_merge.indices_in_file.insert(columns_to_merge.indices_in_file.end(), package_columns.indices_in_file.begin(),
+                                                    package_columns.indices_in_file.end());
+            columns_to_merge.data.insert(columns_to_merge.data.end(), package_columns.data.begin(), package_columns.data.end());
+        }
+    }
+    decoded_packages.packages_id_with_columns.clear();
+
+    timestamp_s_range_of_loaded_log_.first = std::min(timestamp_s_range_of_loaded_log_.first, decoded_packages.timestamp_s_range.first);
+    timestamp_s_range_of_loaded_log_.second = std::max(timestamp_s_range_of_loaded_log_.second, decoded_packages.timestamp_s_range.second);
 }
 
 bool BinaryDataLog::CheckLogFileHeader() {
-    file_r_ptr_->seekg(0);
-
-    std::string temp_header = binary_log_file_header;
-    file_r_ptr_->read(const_cast<char *>(temp_header.data()), binary_log_file_header.size());
-    if (temp_header != binary_log_file_header) {
-        ReportWarn("[DataLog] Log header error, it cannot be decoded.");
-        return false;
+    const uint32_t header_size = binary_log_file_header.size();
+    if (mapped_file_r_.IsInside(0, header_size)) {
+        const char *header_ptr = reinterpret_cast<const char *>(mapped_file_r_.data());
+        if (binary_log_file_header.compare(0, header_size, header_ptr, header_size) == 0) {
+            frame_check_type_ = FrameCheckType::kSummaryByte;
+            return true;
+        }
+        if (binary_log_file_header_with_crc32c.compare(0, header_size, header_ptr, header_size) == 0) {
+            frame_check_type_ = FrameCheckType::kCrc32c;
+            return true;
+        }
     }
-    return true;
+
+    ReportWarn("[DataLog] Log header error, it cannot be decoded.");
+    return false;
 }
 
 bool BinaryDataLog::LoadRegisteredPackagesFromFileHead() {
-    file_r_ptr_->seekg(binary_log_file_header.size());
-
     packages_id_with_objects_.clear();
 
     // Load offset index to the beginning of 'packages_content'.
+    const uint8_t *file_ptr = mapped_file_r_.data();
+    const uint64_t index_in_file_of_names = binary_log_file_header.size();
     uint32_t offset_to_data_part = 0;
-    file_r_ptr_->read(reinterpret_cast<char *>(&offset_to_data_part), 4);
-
-    // Check if this is the end of log file.
-    RETURN_FALSE_IF(file_r_ptr_->eof());
+    RETURN_FALSE_IF(!mapped_file_r_.IsInside(index_in_file_of_names, 4));
+    std::memcpy(&offset_to_data_part, file_ptr + index_in_file_of_names, 4);
+    RETURN_FALSE_IF(!mapped_file_r_.IsInside(index_in_file_of_names, offset_to_data_part));
+    index_in_file_of_content_ = index_in_file_of_names + offset_to_data_part;
 
     // Load information of all registered packages.
-    uint32_t offset = 4 + 1;
-    while (offset < offset_to_data_part) {
+    uint64_t index_in_file = index_in_file_of_names + 4;
+    while (index_in_file < index_in_file_of_content_) {
         // Load offset to the next package.
         uint32_t offset_to_next_package = 0;
-        file_r_ptr_->read(reinterpret_cast<char *>(&offset_to_next_package), 4);
-        uint8_t sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&offset_to_next_package), 4, 0);
+        RETURN_FALSE_IF(index_in_file + 4 > index_in_file_of_content_);
+        std::memcpy(&offset_to_next_package, file_ptr + index_in_file, 4);
+        // Offset, package id, length of package name and sum check byte.
+        if (offset_to_next_package < 4 + 2 + 1 + 1 || index_in_file + offset_to_next_package > index_in_file_of_content_) {
+            ReportWarn("[DataLog] Package offset " << offset_to_next_package << " is broken.");
+            return false;
+        }
+        const uint8_t *package_ptr = file_ptr + index_in_file;
+        index_in_file += offset_to_next_package;
 
-        offset += offset_to_next_package;
+        // Summary byte check.
+        const uint32_t size_except_check = offset_to_next_package - 1;
+        const uint8_t sum_check_byte = SummaryBytes(package_ptr, size_except_check, 0);
+        const uint8_t loaded_sum_check_byte = package_ptr[size_except_check];
+        if (sum_check_byte != loaded_sum_check_byte) {
+            ReportWarn("[DataLog] Package summary check byte failed. Compute " << static_cast<int32_t>(sum_check_byte)
+                                                                               << " != " << static_cast<int32_t>(loaded_sum_check_byte));
+            return false;
+        }
 
         // Load information of a package.
-        // Load package id.
-        std::unique_ptr<PackageInfo> package_ptr = std::make_unique<PackageInfo>();
-        file_r_ptr_->read(reinterpret_cast<char *>(&package_ptr->id), 2);
-        sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&package_ptr->id), 2, sum_check_byte);
-        // Load package name length.
-        uint8_t package_name_length = 0;
-        file_r_ptr_->read(reinterpret_cast<char *>(&package_name_length), 1);
-        sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&package_name_length), 1, sum_check_byte);
-        // Load package name.
-        package_ptr->name = LoadStringFromBinaryFile(package_name_length);
-        sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(package_ptr->name.data()), package_name_length, sum_check_byte);
-
-        uint32_t offset_in_package = 4 + 2 + 1 + package_name_length + 1;
+        // Load package id, package name length and package name.
+        std::unique_ptr<PackageInfo> package_ptr_to_register = std::make_unique<PackageInfo>();
+        std::memcpy(&package_ptr_to_register->id, package_ptr + 4, 2);
+        const uint8_t package_name_length = package_ptr[6];
+        RETURN_FALSE_IF(4 + 2 + 1 + static_cast<uint32_t>(package_name_length) > size_except_check);
+        package_ptr_to_register->name.assign(reinterpret_cast<const char *>(package_ptr + 7), package_name_length);
+
+        uint32_t offset_in_package = 4 + 2 + 1 + package_name_length;
         uint32_t item_data_index_in_package_data = 0;
-        while (offset_in_package < offset_to_next_package) {
-            package_ptr->items.emplace_back(PackageItemInfo());
-            auto &new_item = package_ptr->items.back();
-            new_item.bindata_index_in_package = item_data_index_in_package_data;
-
+        while (offset_in_package < size_except_check) {
             // Load information of an item.
-            // Load item type.
-            file_r_ptr_->read(reinterpret_cast<char *>(&new_item.type), 1);
-            sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&new_item.type), 1, sum_check_byte);
+            // Load item type, item name length and item name.
+            RETURN_FALSE_IF(offset_in_package + 2 > size_except_check);
+            package_ptr_to_register->items.emplace_back(PackageItemInfo());
+            auto &new_item = package_ptr_to_register->items.back();
+            new_item.bindata_index_in_package = item_data_index_in_package_data;
+            new_item.type = static_cast<ItemType>(package_ptr[offset_in_package]);
+            RETURN_FALSE_IF(static_cast<uint32_t>(new_item.type) >= item_type_sizes.size());
             item_data_index_in_package_data += item_type_sizes[static_cast<uint32_t>(new_item.type)];
-            // Load item name length.
-            uint8_t item_name_length = 0;
-            file_r_ptr_->read(reinterpret_cast<char *>(&item_name_length), 1);
-            sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&item_name_length), 1, sum_check_byte);
-            // Load item name.
-            new_item.name = LoadStringFromBinaryFile(item_name_length);
-            sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(new_item.name.data()), item_name_length, sum_check_byte);
+            const uint8_t item_name_length = package_ptr[offset_in_package + 1];
+            RETURN_FALSE_IF(offset_in_package + 2 + item_name_length > size_except_check);
+            new_item.name.assign(reinterpret_cast<const char *>(package_ptr + offset_in_package + 2), item_name_length);
 
             offset_in_package += item_name_length + 2;
         }
 
-        // Summary byte check.
-        uint8_t loaded_sum_check_byte = 0;
-        file_r_ptr_->read(reinterpret_cast<char *>(&loaded_sum_check_byte), 1);
-        if (sum_check_byte != loaded_sum_check_byte) {
-            ReportWarn("[DataLog] Package summary check byte failed. Compute " << static_cast<int32_t>(sum_check_byte)
-                                                                               << " != " << static_cast<int32_t>(loaded_sum_check_byte));
-            return false;
-        }
-
-        RegisterPackage(package_ptr);
+        RegisterPackage(package_ptr_to_register);
     }
 
     return true;
 }
 
-bool BinaryDataLog::LoadOnePackage(bool load_dynamic_package_full_data) {
+void BinaryDataLog::SelectPackagesToLoad() {
+    is_package_id_selected_.clear();
+    if (package_ids_to_load_.empty() && package_names_to_load_.empty()) {
+        return;
+    }
+
+    is_package_id_selected_.resize(std::numeric_limits<uint16_t>::max() + 1, false);
+    for (const uint16_t package_id: package_ids_to_load_) {
+        if (packages_id_with_objects_.find(package_id) == packages_id_with_objects_.end()) {
+            ReportWarn("[DataLog] Package id " << package_id << " to load is not registered.");
+        }
+        is_package_id_selected_[package_id] = true;
+    }
+    for (const auto &package_name: package_names_to_load_) {
+        bool is_registered = false;
+        for (const auto &pair: packages_id_with_objects_) {
+            if (pair.second->name == package_name) {
+                is_package_id_selected_[pair.first] = true;
+                is_registered = true;
+            }
+        }
+        if (!is_registered) {
+            ReportWarn("[DataLog] Package name [" << package_name << "] to load is not registered.");
+        }
+    }
+    // Footer index is never loaded as a package.
+    is_package_id_selected_[kFooterIndexPackageId] = false;
+}
+
+bool BinaryDataLog::CheckFrameInLogFile(const uint64_t index_in_file, const uint32_t size_except_check) const {
+    const uint32_t check_size = FrameCheckSize();
+    RETURN_FALSE_IF(!mapped_file_r_.IsInside(index_in_file, static_cast<uint64_t>(size_except_check) + check_size));
+
+    const uint8_t *frame_ptr = mapped_file_r_.data() + index_in_file;
+    uint32_t loaded_check_value = 0;
+    std::memcpy(&loaded_check_value, frame_ptr + size_except_check, check_size);
+    return UpdateFrameCheckValue(frame_ptr, size_except_check, 0) == loaded_check_value;
+}
+
+bool BinaryDataLog::LoadOnePackage(uint64_t &index_in_file, DecodedPackages &decoded_packages, bool load_dynamic_package_full_data,
+                                   bool load_static_package_full_data) const {
     // Record the index in log file.
     PackageDataPerTick timestamped_data;
-    timestamped_data.index_in_file = file_r_ptr_->tellg();
+    timestamped_data.index_in_file = index_in_file;
+
+    // Check if this is the end of log file.
+    if (!mapped_file_r_.IsInside(index_in_file, 4 + 2 + 4)) {
+        index_in_file = mapped_file_r_.size();
+        return false;
+    }
+    const uint8_t *frame_ptr = mapped_file_r_.data() + index_in_file;
 
     // Load offset to the next content.
     uint32_t offset_to_next_content = 0;
-    file_r_ptr_->read(reinterpret_cast<char *>(&offset_to_next_content), 4);
-    uint8_t sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&offset_to_next_content), 4, 0);
+    std::memcpy(&offset_to_next_content, frame_ptr, 4);
     timestamped_data.size_of_all_in_file = offset_to_next_content;
+    if (offset_to_next_content < 4 + 2 + 4 + FrameCheckSize()) {
+        ReportWarn("[DataLog] Offset to next package is broken. Index in file : " << index_in_file << ". Stop loading.");
+        index_in_file = mapped_file_r_.size();
+        return false;
+    }
 
-    // Check if this is the end of log file.
-    RETURN_FALSE_IF(file_r_ptr_->eof());
+    // Locate to the position of next package.
+    index_in_file += offset_to_next_content;
 
     // Load package id.
     uint16_t package_id = 0;
-    file_r_ptr_->read(reinterpret_cast<char *>(&package_id), 2);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&package_id), 2, sum_check_byte);
+    std::memcpy(&package_id, frame_ptr + 4, 2);
+
+    // Footer index is not a package of data, skip it. Packages not selected are skipped without reading payload.
+    if (package_id == kFooterIndexPackageId || !IsPackageSelectedToLoad(package_id)) {
+        return true;
+    }
 
     // Check if this data package id is registered.
     const auto it = packages_id_with_objects_.find(package_id);
     if (it == packages_id_with_objects_.end()) {
         ReportWarn("[DataLog] Load one package data failed. Package id " << package_id << " is not registered.");
-        // If this is not the end of file, locate to the position of next package.
-        if (!file_r_ptr_->eof()) {
-            file_r_ptr_->seekg(timestamped_data.index_in_file, std::ios::beg);
-            file_r_ptr_->seekg(offset_to_next_content, std::ios::cur);
-        }
         return false;
     }
 
     // Load system timestamp.
-    file_r_ptr_->read(reinterpret_cast<char *>(&timestamped_data.timestamp_s), 4);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&timestamped_data.timestamp_s), 4, sum_check_byte);
+    std::memcpy(&timestamped_data.timestamp_s, frame_ptr + 6, 4);
     // Update timestamp range.
-    timestamp_s_range_of_loaded_log_.first = std::min(timestamp_s_range_of_loaded_log_.first, timestamped_data.timestamp_s);
-    timestamp_s_range_of_loaded_log_.second = std::max(timestamp_s_range_of_loaded_log_.second, timestamped_data.timestamp_s);
+    auto &timestamp_s_range = decoded_packages.timestamp_s_range;
+    timestamp_s_range.first = std::min(timestamp_s_range.first, timestamped_data.timestamp_s);
+    timestamp_s_range.second = std::max(timestamp_s_range.second, timestamped_data.timestamp_s);
 
     // Load data.
     const uint32_t data_size = it->second->size;
     bool load_result = true;
     if (data_size == 0) {
-        load_result = LoadOnePackageWithDynamicSize(*(it->second), sum_check_byte, timestamped_data, package_id, load_dynamic_package_full_data);
+        load_result = LoadOnePackageWithDynamicSize(*(it->second), timestamped_data, package_id, load_dynamic_package_full_data, decoded_packages);
     } else {
-        load_result = LoadOnePackageWithStaticSize(sum_check_byte, timestamped_data, package_id, data_size, true);
+        load_result = LoadOnePackageWithStaticSize(timestamped_data, package_id, data_size, load_static_package_full_data, decoded_packages);
     }
     if (!load_result) {
         ReportWarn("[DataLog] Load one package data failed for checking byte. Index in file : " << timestamped_data.index_in_file << ". Data size ["
                                                                                                 << data_size << "]. Skip to load next package.");
     }
 
-    // Locate to the position of next package.
-    file_r_ptr_->seekg(timestamped_data.index_in_file, std::ios::beg);
-    file_r_ptr_->seekg(offset_to_next_content, std::ios::cur);
-
     return load_result;
 }
 
-bool BinaryDataLog::LoadOnePackageWithStaticSize(uint8_t &sum_check_byte, PackageDataPerTick &timestamped_data, uint16_t package_id, uint32_t data_size,
-                                                 bool load_full_data) {
-    char *buffer = new char[data_size];
-    file_r_ptr_->read(buffer, data_size);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(buffer), data_size, sum_check_byte);
-
-    // Check summary byte.
-    uint8_t loaded_sum_check_byte = 0;
-    file_r_ptr_->read(reinterpret_cast<char *>(&loaded_sum_check_byte), 1);
-    if (loaded_sum_check_byte != sum_check_byte) {
+bool BinaryDataLog::LoadOnePackageWithStaticSize(PackageDataPerTick &timestamped_data, uint16_t package_id, uint32_t data_size, bool load_full_data,
+                                                 DecodedPackages &decoded_packages) const {
+    // Check summary byte or CRC32C.
+    if (!CheckFrameInLogFile(timestamped_data.index_in_file, 4 + 2 + 4 + data_size)) {
         ReportWarn("[DataLog] Load one package data failed. Summary check error.");
-        delete[] buffer;
         return false;
     }
 
+    // Store this data package in columns, which has no allocation for each tick.
+    const uint8_t *data_ptr = mapped_file_r_.data() + timestamped_data.index_in_file + 4 + 2 + 4;
+    if (load_full_data && load_static_package_in_columns_) {
+        auto &columns = decoded_packages.packages_id_with_columns[package_id];
+        if (!columns.timestamps_s.empty() && timestamped_data.timestamp_s == columns.timestamps_s.back()) {
+            ReportWarn("[DataLog] Same timestamp " << timestamped_data.timestamp_s << "s of package [id][" << package_id
+                                                   << "] is detected when decoding static size data package.");
+        }
+        columns.size_of_data = data_size;
+        columns.size_of_all_in_file = timestamped_data.size_of_all_in_file;
+        columns.timestamps_s.emplace_back(timestamped_data.timestamp_s);
+        columns.indices_in_file.emplace_back(timestamped_data.index_in_file);
+        columns.data.insert(columns.data.end(), data_ptr, data_ptr + data_size);
+        return true;
+    }
+
     // Store this data package and check timestamp.
-    auto &packages = packages_id_with_data_[package_id];
+    auto &packages = decoded_packages.packages_id_with_data[package_id];
     if (!packages.empty() && timestamped_data.timestamp_s == packages.back().timestamp_s) {
         ReportWarn("[DataLog] Same timestamp " << timestamped_data.timestamp_s << "s of package [id][" << package_id
                                                << "] is detected when decoding static size data package.");
@@ -226,68 +430,60 @@ bool BinaryDataLog::LoadOnePackageWithStaticSize(uint8_t &sum_check_byte, Packag
     packages.emplace_back(timestamped_data);
 
     if (load_full_data) {
-        packages.back().data.reserve(data_size);
-        for (uint32_t i = 0; i < data_size; ++i) {
-            packages.back().data.emplace_back(buffer[i]);
-        }
+        packages.back().data.assign(data_ptr, data_ptr + data_size);
     }
-    delete[] buffer;
 
     return true;
 }
 
-bool BinaryDataLog::LoadOnePackageWithDynamicSize(PackageInfo &package_info, uint8_t &sum_check_byte, PackageDataPerTick &timestamped_data, uint16_t package_id,
-                                                  bool load_full_data) {
-    RETURN_FALSE_IF(package_info.items.empty());
-
-    // Compute data size in different type.
-    uint32_t data_size = 0;
-    switch (package_info.items.front().type) {
+bool BinaryDataLog::ComputeDataSizeOfDynamicPackage(const ItemType type, const uint64_t index_in_file_of_data, uint32_t &data_size) const {
+    // Compute data size in different type. Size is computed from the head of data, which may be broken, so it is computed in 64 bits.
+    const uint8_t *data_ptr = mapped_file_r_.data() + index_in_file_of_data;
+    uint64_t size = 0;
+    switch (type) {
         case ItemType::kImage: {
+            RETURN_FALSE_IF(!mapped_file_r_.IsInside(index_in_file_of_data, 5));
             uint8_t channels = 0;
             uint16_t image_rows = 0;
             uint16_t image_cols = 0;
-            file_r_ptr_->read(reinterpret_cast<char *>(&channels), 1);
-            file_r_ptr_->read(reinterpret_cast<char *>(&image_rows), 2);
-            file_r_ptr_->read(reinterpret_cast<char *>(&image_cols), 2);
-
-            data_size = 5 + channels * image_rows * image_cols;
-            file_r_ptr_->seekg(-5, std::ios::cur);
+            std::memcpy(&channels, data_ptr, 1);
+            std::memcpy(&image_rows, data_ptr + 1, 2);
+            std::memcpy(&image_cols, data_ptr + 3, 2);
+            size = 5 + static_cast<uint64_t>(channels) * image_rows * image_cols;
             break;
         }
 
         case ItemType::kMatrix: {
+            RETURN_FALSE_IF(!mapped_file_r_.IsInside(index_in_file_of_data, 4));
             uint16_t matrix_rows = 0;
             uint16_t matrix_cols = 0;
-            file_r_ptr_->read(reinterpret_cast<char *>(&matrix_rows), 2);
-            file_r_ptr_->read(reinterpret_cast<char *>(&matrix_cols), 2);
-
-            data_size = 4 + matrix_rows * matrix_cols * sizeof(float);
-            file_r_ptr_->seekg(-4, std::ios::cur);
+            std::memcpy(&matrix_rows, data_ptr, 2);
+            std::memcpy(&matrix_cols, data_ptr + 2, 2);
+            size = 4 + static_cast<uint64_t>(matrix_rows) * matrix_cols * sizeof(float);
             break;
         }
 
         case ItemType::kPngImage: {
+            RETURN_FALSE_IF(!mapped_file_r_.IsInside(index_in_file_of_data, 4));
             uint32_t num_of_png_bytes = 0;
-            file_r_ptr_->read(reinterpret_cast<char *>(&num_of_png_bytes), 4);
-            data_size = 4 + num_of_png_bytes;
-            file_r_ptr_->seekg(-4, std::ios::cur);
+            std::memcpy(&num_of_png_bytes, data_ptr, 4);
+            size = 4 + static_cast<uint64_t>(num_of_png_bytes);
             break;
         }
 
         case ItemType::kPointCloud: {
+            RETURN_FALSE_IF(!mapped_file_r_.IsInside(index_in_file_of_data, 4));
             uint32_t num_of_points = 0;
-            file_r_ptr_->read(reinterpret_cast<char *>(&num_of_points), 4);
-            data_size = 4 + num_of_points * 3 * sizeof(float);
-            file_r_ptr_->seekg(-4, std::ios::cur);
+            std::memcpy(&num_of_points, data_ptr, 4);
+            size = 4 + static_cast<uint64_t>(num_of_points) * 3 * sizeof(float);
             break;
         }
 
         case ItemType::kLineCloud: {
+            RETURN_FALSE_IF(!mapped_file_r_.IsInside(index_in_file_of_data, 4));
             uint32_t num_of_lines = 0;
-            file_r_ptr_->read(reinterpret_cast<char *>(&num_of_lines), 4);
-            data_size = 4 + num_of_lines * 2 * 3 * sizeof(float);
-            file_r_ptr_->seekg(-4, std::ios::cur);
+            std::memcpy(&num_of_lines, data_ptr, 4);
+            size = 4 + static_cast<uint64_t>(num_of_lines) * 2 * 3 * sizeof(float);
             break;
         }
 
@@ -295,23 +491,31 @@ bool BinaryDataLog::LoadOnePackageWithDynamicSize(PackageInfo &package_info, uin
             return false;
     }
 
-    // Load total data of dynamic size package.
+    // Whole frame is measured by 32 bits offset, and data should be located inside of log file.
+    RETURN_FALSE_IF(size > std::numeric_limits<uint32_t>::max() - (4 + 2 + 4) - FrameCheckSize());
+    RETURN_FALSE_IF(!mapped_file_r_.IsInside(index_in_file_of_data, size));
+    data_size = static_cast<uint32_t>(size);
+    return true;
+}
+
+bool BinaryDataLog::LoadOnePackageWithDynamicSize(const PackageInfo &package_info, PackageDataPerTick &timestamped_data, uint16_t package_id,
+                                                  bool load_full_data, DecodedPackages &decoded_packages) const {
+    RETURN_FALSE_IF(package_info.items.empty());
+
+    // Compute data size in different type.
+    const uint64_t index_in_file_of_data = timestamped_data.index_in_file + 4 + 2 + 4;
+    uint32_t data_size = 0;
+    RETURN_FALSE_IF(!ComputeDataSizeOfDynamicPackage(package_info.items.front().type, index_in_file_of_data, data_size));
     RETURN_FALSE_IF(data_size < 1);
-    char *buffer = new char[data_size];
-    file_r_ptr_->read(buffer, data_size);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(buffer), data_size, sum_check_byte);
-
-    // Check summary byte.
-    uint8_t loaded_sum_check_byte = 0;
-    file_r_ptr_->read(reinterpret_cast<char *>(&loaded_sum_check_byte), 1);
-    if (loaded_sum_check_byte != sum_check_byte) {
+
+    // Check summary byte or CRC32C.
+    if (!CheckFrameInLogFile(timestamped_data.index_in_file, 4 + 2 + 4 + data_size)) {
         ReportWarn("[DataLog] Load one package data failed. Summary check error.");
-        delete[] buffer;
         return false;
     }
 
     // Store this data package and check timestamp.
-    auto &packages = packages_id_with_data_[package_id];
+    auto &packages = decoded_packages.packages_id_with_data[package_id];
     if (!packages.empty() && timestamped_data.timestamp_s == packages.back().timestamp_s) {
         ReportWarn("[DataLog] Same timestamp " << timestamped_data.timestamp_s << "s of package [id][" << package_id
                                                << "] is detected when decoding dynamic size data package.");
@@ -320,12 +524,9 @@ bool BinaryDataLog::LoadOnePackageWithDynamicSize(PackageInfo &package_info, uin
 
     // For package with dynamic size, only store the localtion of data will be better.
     if (load_full_data) {
-        packages.back().data.reserve(data_size);
-        for (uint32_t i = 0; i < data_size; ++i) {
-            packages.back().data.emplace_back(buffer[i]);
-        }
+        const uint8_t *data_ptr = mapped_file_r_.data() + index_in_file_of_data;
+        packages.back().data.assign(data_ptr, data_ptr + data_size);
     }
-    delete[] buffer;
 
     return true;
 }
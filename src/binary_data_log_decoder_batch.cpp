@@ -0,0 +1,238 @@
+#include "binary_data_log.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "algorithm"
+#include "cmath"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include "immintrin.h"
+#define BINARY_DATA_LOG_X86_KERNELS
+#endif
+
+namespace slam_data_log {
+
+namespace {
+    constexpr float kRadToDeg = 57.295779579f;
+
+    uint32_t NumOfComponentsOfDecoder(const DecodeType decoder) {
+        switch (decoder) {
+            case DecodeType::kQuaternionToRoll:
+            case DecodeType::kQuaternionToPitch:
+            case DecodeType::kQuaternionToYaw:
+                return 4;
+            case DecodeType::kVector2dToMod:
+                return 2;
+            case DecodeType::kVector3dToMod:
+                return 3;
+            default:
+                return 1;
+        }
+    }
+
+    // Same as ConvertBytes with DecodeType, p[i] is the i-th component of this tick.
+    float DecodeScalar(const float *const *p, const uint32_t i, const DecodeType decoder) {
+        switch (decoder) {
+            case DecodeType::kQuaternionToRoll:
+                return std::atan2(2.0f * (p[0][i] * p[1][i] + p[2][i] * p[3][i]), 1.0f - 2.0f * (p[1][i] * p[1][i] + p[2][i] * p[2][i])) * kRadToDeg;
+            case DecodeType::kQuaternionToPitch:
+                return std::asin(2.0f * (p[0][i] * p[2][i] - p[3][i] * p[1][i])) * kRadToDeg;
+            case DecodeType::kQuaternionToYaw:
+                return std::atan2(2.0f * (p[0][i] * p[3][i] + p[1][i] * p[2][i]), 1.0f - 2.0f * (p[2][i] * p[2][i] + p[3][i] * p[3][i])) * kRadToDeg;
+            case DecodeType::kVector2dToMod:
+                return std::sqrt(p[0][i] * p[0][i] + p[1][i] * p[1][i]);
+            case DecodeType::kVector3dToMod:
+                return std::sqrt(p[0][i] * p[0][i] + p[1][i] * p[1][i] + p[2][i] * p[2][i]);
+            default:
+                return p[0][i];
+        }
+    }
+
+#ifdef BINARY_DATA_LOG_X86_KERNELS
+    // Branchless atan2 of 8 lanes. Argument is reduced into [0, tan(pi/8)], then approximated by polynomial of cephes atanf.
+    __attribute__((target("avx2"))) inline __m256 Atan2Avx2(const __m256 y, const __m256 x) {
+        const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+        const __m256 abs_x = _mm256_andnot_ps(sign_mask, x);
+        const __m256 abs_y = _mm256_andnot_ps(sign_mask, y);
+        const __m256 max_xy = _mm256_max_ps(abs_x, abs_y);
+        const __m256 min_xy = _mm256_min_ps(abs_x, abs_y);
+        const __m256 is_zero = _mm256_cmp_ps(max_xy, _mm256_setzero_ps(), _CMP_EQ_OQ);
+        __m256 a = _mm256_andnot_ps(is_zero, _mm256_div_ps(min_xy, max_xy));
+
+        // atan(a) = pi/4 + atan((a - 1) / (a + 1)).
+        const __m256 is_large = _mm256_cmp_ps(a, _mm256_set1_ps(0.4142135623730950f), _CMP_GT_OQ);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        a = _mm256_blendv_ps(a, _mm256_div_ps(_mm256_sub_ps(a, one), _mm256_add_ps(a, one)), is_large);
+        const __m256 offset = _mm256_and_ps(is_large, _mm256_set1_ps(0.78539816339744830962f));
+
+        const __m256 z = _mm256_mul_ps(a, a);
+        __m256 r = _mm256_set1_ps(8.05374449538e-2f);
+        r = _mm256_sub_ps(_mm256_mul_ps(r, z), _mm256_set1_ps(1.38776856032e-1f));
+        r = _mm256_add_ps(_mm256_mul_ps(r, z), _mm256_set1_ps(1.99777106478e-1f));
+        r = _mm256_sub_ps(_mm256_mul_ps(r, z), _mm256_set1_ps(3.33329491539e-1f));
+        r = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(r, z), a), a);
+        r = _mm256_add_ps(r, offset);
+
+        // Recover quadrant by |y| > |x|, sign of x and sign of y.
+        r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(1.57079632679489661923f), r), _mm256_cmp_ps(abs_y, abs_x, _CMP_GT_OQ));
+        r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(3.14159265358979323846f), r), x);
+        return _mm256_or_ps(r, _mm256_and_ps(y, sign_mask));
+    }
+
+    // Branchless asin of 8 lanes by polynomial of cephes asinf. It is nan if |v| > 1, as std::asin.
+    __attribute__((target("avx2"))) inline __m256 AsinAvx2(const __m256 v) {
+        const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+        const __m256 abs_v = _mm256_andnot_ps(sign_mask, v);
+        const __m256 half = _mm256_set1_ps(0.5f);
+
+        // asin(a) = pi/2 - 2 * asin(sqrt((1 - a) / 2)) if a > 0.5.
+        const __m256 is_large = _mm256_cmp_ps(abs_v, half, _CMP_GT_OQ);
+        const __m256 z = _mm256_blendv_ps(_mm256_mul_ps(abs_v, abs_v), _mm256_mul_ps(half, _mm256_sub_ps(_mm256_set1_ps(1.0f), abs_v)), is_large);
+        const __m256 a = _mm256_blendv_ps(abs_v, _mm256_sqrt_ps(z), is_large);
+
+        __m256 r = _mm256_set1_ps(4.2163199048e-2f);
+        r = _mm256_add_ps(_mm256_mul_ps(r, z), _mm256_set1_ps(2.4181311049e-2f));
+        r = _mm256_add_ps(_mm256_mul_ps(r, z), _mm256_set1_ps(4.5470025998e-2f));
+        r = _mm256_add_ps(_mm256_mul_ps(r, z), _mm256_set1_ps(7.4953002686e-2f));
+        r = _mm256_add_ps(_mm256_mul_ps(r, z), _mm256_set1_ps(1.6666752422e-1f));
+        r = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(r, z), a), a);
+        r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(1.57079632679489661923f), _mm256_add_ps(r, r)), is_large);
+
+        r = _mm256_or_ps(r, _mm256_and_ps(v, sign_mask));
+        const __m256 is_out_of_range = _mm256_cmp_ps(abs_v, _mm256_set1_ps(1.0f), _CMP_GT_OQ);
+        return _mm256_blendv_ps(r, _mm256_set1_ps(NAN), is_out_of_range);
+    }
+
+    // Arguments are computed in the same order as scalar decoder, so only math functions are approximated.
+    __attribute__((target("avx2"))) uint32_t DecodeColumnsAvx2(const float *const *p, const uint32_t size, const DecodeType decoder, float *values) {
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 two = _mm256_set1_ps(2.0f);
+        const __m256 rad_to_deg = _mm256_set1_ps(kRadToDeg);
+        uint32_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            const __m256 p0 = _mm256_loadu_ps(p[0] + i);
+            __m256 value;
+            switch (decoder) {
+                case DecodeType::kQuaternionToRoll:
+                case DecodeType::kQuaternionToYaw: {
+                    const __m256 p1 = _mm256_loadu_ps(p[1] + i);
+                    const __m256 p2 = _mm256_loadu_ps(p[2] + i);
+                    const __m256 p3 = _mm256_loadu_ps(p[3] + i);
+                    __m256 y;
+                    __m256 x;
+                    if (decoder == DecodeType::kQuaternionToRoll) {
+                        y = _mm256_mul_ps(two, _mm256_add_ps(_mm256_mul_ps(p0, p1), _mm256_mul_ps(p2, p3)));
+                        x = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(_mm256_mul_ps(p1, p1), _mm256_mul_ps(p2, p2))));
+                    } else {
+                        y = _mm256_mul_ps(two, _mm256_add_ps(_mm256_mul_ps(p0, p3), _mm256_mul_ps(p1, p2)));
+                        x = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(_mm256_mul_ps(p2, p2), _mm256_mul_ps(p3, p3))));
+                    }
+                    value = _mm256_mul_ps(Atan2Avx2(y, x), rad_to_deg);
+                    break;
+                }
+                case DecodeType::kQuaternionToPitch: {
+                    const __m256 p1 = _mm256_loadu_ps(p[1] + i);
+                    const __m256 p2 = _mm256_loadu_ps(p[2] + i);
+                    const __m256 p3 = _mm256_loadu_ps(p[3] + i);
+                    const __m256 v = _mm256_mul_ps(two, _mm256_sub_ps(_mm256_mul_ps(p0, p2), _mm256_mul_ps(p3, p1)));
+                    value = _mm256_mul_ps(AsinAvx2(v), rad_to_deg);
+                    break;
+                }
+                case DecodeType::kVector2dToMod: {
+                    const __m256 p1 = _mm256_loadu_ps(p[1] + i);
+                    value = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(p0, p0), _mm256_mul_ps(p1, p1)));
+                    break;
+                }
+                case DecodeType::kVector3dToMod: {
+                    const __m256 p1 = _mm256_loadu_ps(p[1] + i);
+                    const __m256 p2 = _mm256_loadu_ps(p[2] + i);
+                    value = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p0, p0), _mm256_mul_ps(p1, p1)), _mm256_mul_ps(p2, p2)));
+                    break;
+                }
+                default: {
+                    value = p0;
+                    break;
+                }
+            }
+            _mm256_storeu_ps(values + i, value);
+        }
+        return i;
+    }
+
+    bool IsAvx2Supported() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    }
+#endif
+}  // namespace
+
+bool BinaryDataLog::DecodeColumns(const std::vector<std::vector<float>> &components, const DecodeType decoder, std::vector<float> &values,
+                                  const uint32_t index_of_first_component) {
+    // Check if there are enough components, and all of them have the same size.
+    const uint32_t num_of_components = NumOfComponentsOfDecoder(decoder);
+    if (index_of_first_component + num_of_components > components.size()) {
+        ReportWarn("[DataLog] Decoder " << static_cast<int32_t>(decoder) << " needs " << num_of_components << " components.");
+        return false;
+    }
+    std::vector<const float *> p(num_of_components);
+    const uint32_t size = components[index_of_first_component].size();
+    for (uint32_t i = 0; i < num_of_components; ++i) {
+        RETURN_FALSE_IF(components[index_of_first_component + i].size() != size);
+        p[i] = components[index_of_first_component + i].data();
+    }
+
+    values.resize(size);
+    uint32_t i = 0;
+#ifdef BINARY_DATA_LOG_X86_KERNELS
+    static const bool kIsAvx2Supported = IsAvx2Supported();
+    if (kIsAvx2Supported) {
+        i = DecodeColumnsAvx2(p.data(), size, decoder, values.data());
+    }
+#endif
+    for (; i < size; ++i) {
+        values[i] = DecodeScalar(p.data(), i, decoder);
+    }
+    return true;
+}
+
+bool BinaryDataLog::ExtractDecodedItemColumn(const uint16_t package_id, const std::string &item_name, const DecodeType decoder,
+                                             std::vector<float> &column) const {
+    column.clear();
+    const auto package_it = packages_id_with_objects_.find(package_id);
+    RETURN_FALSE_IF(package_it == packages_id_with_objects_.end());
+    const auto &items = package_it->second->items;
+    const auto item_it = std::find_if(items.begin(), items.end(), [&item_name](const PackageItemInfo &item) { return item.name == item_name; });
+    RETURN_FALSE_IF(item_it == items.end());
+
+    // Quaternion of kPose6Dof is after its position. Vector is the position of kPose6Dof, or the whole kVector3.
+    std::vector<std::vector<float>> components;
+    const bool is_quaternion_decoder = NumOfComponentsOfDecoder(decoder) == 4;
+    switch (item_it->type) {
+        case ItemType::kPose6Dof: {
+            RETURN_FALSE_IF(!ExtractItemColumns(package_id, item_name, components));
+            return DecodeColumns(components, decoder, column, is_quaternion_decoder ? 3 : 0);
+        }
+        case ItemType::kVector3: {
+            RETURN_FALSE_IF(is_quaternion_decoder || !ExtractItemColumns(package_id, item_name, components));
+            return DecodeColumns(components, decoder, column);
+        }
+        case ItemType::kFloat: {
+            // As ConvertBytes, components are this item and the following items of float in package.
+            const uint32_t num_of_components = NumOfComponentsOfDecoder(decoder);
+            RETURN_FALSE_IF(static_cast<uint32_t>(items.end() - item_it) < num_of_components);
+            for (uint32_t i = 0; i < num_of_components; ++i) {
+                const auto &item = *(item_it + i);
+                RETURN_FALSE_IF(item.type != ItemType::kFloat || item.bindata_index_in_package != item_it->bindata_index_in_package + i * sizeof(float));
+                components.emplace_back();
+                RETURN_FALSE_IF(!ExtractItemColumn(package_id, item.name, components.back()));
+            }
+            return DecodeColumns(components, decoder, column);
+        }
+        default: {
+            ReportWarn("[DataLog] Item [" << item_name << "] of package [id][" << package_id << "] cannot be decoded.");
+            return false;
+        }
+    }
+}
+
+}  // namespace slam_data_log
@@ -0,0 +1,114 @@
+#include "binary_data_log.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "cstring"
+
+namespace slam_data_log {
+
+namespace {
+    // Each thread loads at least this size of log file, otherwise creating threads costs more than loading.
+    constexpr uint64_t kMinSizeOfRangeForParallelLoading = 64 * 1024;
+    // Number of valid frames in a chain to confirm a frame boundary.
+    constexpr uint32_t kNumOfFramesToResynchronize = 4;
+}  // namespace
+
+bool BinaryDataLog::IsFrameBeginningInLogFile(const uint64_t index_in_file) const {
+    RETURN_FALSE_IF(!mapped_file_r_.IsInside(index_in_file, 4 + 2 + 4));
+    const uint8_t *frame_ptr = mapped_file_r_.data() + index_in_file;
+
+    // Offset to next content should be located inside of log file.
+    const uint32_t check_size = FrameCheckSize();
+    uint32_t offset_to_next_content = 0;
+    uint16_t package_id = 0;
+    std::memcpy(&offset_to_next_content, frame_ptr, 4);
+    std::memcpy(&package_id, frame_ptr + 4, 2);
+    RETURN_FALSE_IF(offset_to_next_content < 4 + 2 + 4 + check_size || !mapped_file_r_.IsInside(index_in_file, offset_to_next_content));
+
+    // Package id should be registered, and size of package should match the offset.
+    if (package_id != kFooterIndexPackageId) {
+        const auto it = packages_id_with_objects_.find(package_id);
+        RETURN_FALSE_IF(it == packages_id_with_objects_.end());
+        uint32_t data_size = it->second->size;
+        if (data_size == 0) {
+            RETURN_FALSE_IF(it->second->items.empty());
+            RETURN_FALSE_IF(!ComputeDataSizeOfDynamicPackage(it->second->items.front().type, index_in_file + 4 + 2 + 4, data_size));
+        }
+        RETURN_FALSE_IF(static_cast<uint64_t>(data_size) + 4 + 2 + 4 + check_size != offset_to_next_content);
+    }
+
+    // Summary byte or CRC32C should be correct.
+    return CheckFrameInLogFile(index_in_file, offset_to_next_content - check_size);
+}
+
+uint64_t BinaryDataLog::FindFirstFrameInRange(const uint64_t index_in_file, const uint64_t end_index_in_file) const {
+    for (uint64_t index = index_in_file; index < end_index_in_file; ++index) {
+        // Bytes of data may look like a frame by chance, so check a chain of frames beginning here.
+        uint64_t index_of_frame = index;
+        uint32_t num_of_valid_frames = 0;
+        while (num_of_valid_frames < kNumOfFramesToResynchronize && IsFrameBeginningInLogFile(index_of_frame)) {
+            uint32_t offset_to_next_content = 0;
+            std::memcpy(&offset_to_next_content, mapped_file_r_.data() + index_of_frame, 4);
+            index_of_frame += offset_to_next_content;
+            ++num_of_valid_frames;
+        }
+        if (num_of_valid_frames == kNumOfFramesToResynchronize || (num_of_valid_frames > 0 && index_of_frame == mapped_file_r_.size())) {
+            return index;
+        }
+    }
+    return end_index_in_file;
+}
+
+void BinaryDataLog::LoadAllPackagesInParallel(bool load_dynamic_package_full_data, bool load_static_package_full_data) {
+    const uint64_t index_in_file_of_end = mapped_file_r_.size();
+    const uint64_t size_of_content = index_in_file_of_end > index_in_file_of_content_ ? index_in_file_of_end - index_in_file_of_content_ : 0;
+    const uint64_t num_of_ranges =
+        std::max<uint64_t>(1, std::min<uint64_t>(num_of_threads_for_loading_, size_of_content / kMinSizeOfRangeForParallelLoading));
+
+    // Split content of log file into ranges with the same size.
+    std::vector<uint64_t> index_in_file_of_ranges(num_of_ranges + 1, index_in_file_of_content_);
+    for (uint64_t i = 1; i <= num_of_ranges; ++i) {
+        index_in_file_of_ranges[i] = index_in_file_of_content_ + size_of_content * i / num_of_ranges;
+    }
+
+    // Each thread resynchronizes to the first valid frame in its range, then loads all frames beginning in this range.
+    // The first range begins at a frame boundary, so it has no need to be resynchronized.
+    std::vector<DecodedPackages> decoded_packages_of_ranges(num_of_ranges);
+    std::vector<uint64_t> begin_index_of_ranges(num_of_ranges, index_in_file_of_content_);
+    std::vector<uint64_t> end_index_of_ranges(num_of_ranges, index_in_file_of_content_);
+    const auto load_range = [&](const uint64_t i) {
+        const uint64_t range_end = index_in_file_of_ranges[i + 1];
+        begin_index_of_ranges[i] = i == 0 ? index_in_file_of_content_ : FindFirstFrameInRange(index_in_file_of_ranges[i], range_end);
+        end_index_of_ranges[i] = LoadPackagesInRange(begin_index_of_ranges[i], range_end, load_dynamic_package_full_data, load_static_package_full_data,
+                                                     decoded_packages_of_ranges[i]);
+    };
+    std::vector<std::thread> threads;
+    for (uint64_t i = 1; i < num_of_ranges; ++i) {
+        threads.emplace_back(load_range, i);
+    }
+    load_range(0);
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    // Merge all ranges in file order. The frame chain is decided by offsets, so the first frame of a range must be the one which
+    // the last range ends at. If not, this thread resynchronized to bytes which only look like a frame, so load this range again.
+    uint64_t index_in_file = index_in_file_of_content_;
+    for (uint64_t i = 0; i < num_of_ranges; ++i) {
+        const uint64_t range_end = index_in_file_of_ranges[i + 1];
+        if (index_in_file >= range_end) {
+            // The last frame of previous range covers this whole range.
+            continue;
+        }
+        if (begin_index_of_ranges[i] != index_in_file) {
+            ReportWarn("[DataLog] Frame boundary of range [" << index_in_file_of_ranges[i] << ", " << range_end << ") is not matched, load it again.");
+            decoded_packages_of_ranges[i] = DecodedPackages();
+            end_index_of_ranges[i] =
+                LoadPackagesInRange(index_in_file, range_end, load_dynamic_package_full_data, load_static_package_full_data, decoded_packages_of_ranges[i]);
+        }
+        index_in_file = end_index_of_ranges[i];
+        MergeDecodedPackages(decoded_packages_of_ranges[i]);
+    }
+}
+
+}  // namespace slam_data_log
@@ -9,7 +9,8 @@
 
 /* Part 1: Header */
 /*
-[0] - [n]: 'BinaryDataLog', which is fixed texts.
+[0] - [n]: 'BINARY_DATA_LOG', which is fixed texts.
+    If it is 'BINARY_DATA_CRC', each package content is checked by 4 bytes of CRC32C instead of sum check byte.
 */
 
 /* Part 2: Packages' name */
@@ -47,6 +48,7 @@ for each package:
     [10] - [n]: Binary data.(This is the only different part of different packages)
 
     [n + 1]: Sum check byte of this package.
+        Or [n + 1] - [n + 4]: CRC32C of this package, if header is 'BINARY_DATA_CRC'.
 
 for each vecor3 package:
     [10] - [13]: Vector in X axis.
@@ -98,6 +100,33 @@ for each line cloud package:
 
 */
 
+/* Part 4: Footer index */
+/*
+It is appended when log file is closed, and packed as a package content with reserved package id 0xFFFF.
+So decoder without footer index support will skip it as an unregistered package.
+
+[0] - [3]: Offset index to the end of 'footer_index', including the checking bytes.
+[4] - [5]: Package id, which is fixed 0xFFFF.
+[6] - [9]: System timestamp, which is fixed zero.
+[10] - [11]: Number of packages in index.
+
+for each package:
+    [0] - [1]: Package id.
+    [2] - [5]: Number of package contents of this package.
+    [6] - [9]: Minimum timestamp of this package.
+    [10] - [13]: Maximum timestamp of this package.
+
+    for each package content:
+        [0] - [3]: System timestamp of this package content.
+        [4] - [11]: Index in file of this package content.
+        [12] - [15]: Size of all in file of this package content.
+
+[n - 15] - [n - 8]: Index in file of this 'footer_index'.
+[n - 7] - [n]: 'BDLINDEX', which is fixed texts.
+[n + 1]: Sum check byte. Or [n + 1] - [n + 4]: CRC32C.
+
+*/
+
 using namespace slam_utility;
 
 namespace slam_data_log {
@@ -157,7 +186,16 @@ enum class DecodeType : uint8_t {
     kVector3dToMod = 5,
 };
 
+enum class FrameCheckType : uint8_t {
+    kSummaryByte = 0,
+    kCrc32c = 1,
+};
+
 static std::string binary_log_file_header = "BINARY_DATA_LOG";
+static std::string binary_log_file_header_with_crc32c = "BINARY_DATA_CRC";
+static std::string binary_log_file_footer_index_tail = "BDLINDEX";
+static std::string binary_log_sidecar_index_header = "BDLSIDECAR_V1";
+static constexpr uint16_t kFooterIndexPackageId = 0xFFFF;
 
 struct PackageItemInfo {
     ItemType type = ItemType::kUint32;
@@ -167,7 +205,7 @@ struct PackageItemInfo {
 
 struct PackageInfo {
     uint16_t id = 0;
-    // The number of bytes except 10 bytes of package head and 1 byte of sum check.
+    // The number of bytes except 10 bytes of package head and bytes of check.
     // If this is zero, it means unfixed size. Log decoder should better load only package info but not full bytes.
     uint32_t size = 0;
     std::string name;
@@ -178,7 +216,34 @@ struct PackageDataPerTick {
     float timestamp_s = 0.0f;
     std::vector<uint8_t> data;         // Binary data stored in bytes.
     uint64_t index_in_file = 0;        // Start at 'offset'.
-    uint32_t size_of_all_in_file = 0;  // Including offset, id, timestamp, binary_data, check_byte.
+    uint32_t size_of_all_in_file = 0;  // Including offset, id, timestamp, binary_data, check_bytes.
+};
+
+struct PackageDataView {
+    uint16_t package_id = 0;
+    float timestamp_s = 0.0f;
+    const uint8_t *data = nullptr;     // Binary data inside of mapped log file, only valid while visiting.
+    uint32_t size_of_data = 0;
+    uint64_t index_in_file = 0;        // Start at 'offset'.
+    uint32_t size_of_all_in_file = 0;  // Including offset, id, timestamp, binary_data, check_bytes.
+};
+struct PackageIndexPerTick {
+    uint64_t index_in_file = 0;        // Start at 'offset'.
+    float timestamp_s = 0.0f;
+    uint32_t size_of_all_in_file = 0;  // Including offset, id, timestamp, binary_data, check_bytes.
+};
+
+// Data of all ticks of one package with static size. Each member is stored in one contiguous array,
+// so decoding a tick needs no allocation.
+struct PackageDataColumns {
+    uint32_t size_of_data = 0;              // Size of binary data of each tick.
+    uint32_t size_of_all_in_file = 0;       // Including offset, id, timestamp, binary_data, check_bytes.
+    std::vector<float> timestamps_s;
+    std::vector<uint64_t> indices_in_file;  // Start at 'offset'.
+    std::vector<uint8_t> data;              // Binary data of all ticks stored in bytes.
+
+    uint32_t size() const { return static_cast<uint32_t>(timestamps_s.size()); }
+    const uint8_t *data_of_tick(const uint32_t index) const { return data.data() + static_cast<uint64_t>(index) * size_of_data; }
 };
 
 }  // namespace slam_data_log
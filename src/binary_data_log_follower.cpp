@@ -0,0 +1,157 @@
+#include "binary_data_log.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "algorithm"
+#include "cstring"
+#include "tuple"
+
+#include "sys/stat.h"
+
+namespace slam_data_log {
+
+bool BinaryDataLog::FollowLogFile(const std::string &log_file_name, bool load_dynamic_package_full_data) {
+    // Prefetcher reads mapped log file and loaded ticks, which are replaced here.
+    StopPrefetching();
+    is_following_ = false;
+    // Try to map log file. If last log file is not closed, it will be closed.
+    if (!mapped_file_r_.Open(log_file_name)) {
+        ReportError("[DataLog] Cannot open log file : " << log_file_name);
+        return false;
+    }
+    // Binary data cached and pyramids built from last log file are useless.
+    payload_cache_.Clear();
+    packages_id_with_item_pyramids_.clear();
+
+    // Check header.
+    RETURN_FALSE_IF_FALSE(CheckLogFileHeader());
+    // Load all registered packages information.
+    RETURN_FALSE_IF_FALSE(LoadRegisteredPackagesFromFileHead());
+    SelectPackagesToLoad();
+
+    // Load all complete frames recorded until now.
+    packages_id_with_data_.clear();
+    packages_id_with_columns_.clear();
+    timestamp_s_range_of_loaded_log_ = std::make_pair(INFINITY, -INFINITY);
+    follow_dynamic_package_full_data_ = load_dynamic_package_full_data;
+    index_in_file_of_followed_ = index_in_file_of_content_;
+    is_following_ = true;
+    return RefreshFollowedLogFile();
+}
+
+bool BinaryDataLog::RefreshFollowedLogFile() {
+    if (!is_following_) {
+        ReportError("[DataLog] No log file is followed.");
+        return false;
+    }
+
+    // Prefetcher reads mapped log file and loaded ticks, so it is paused while log file is mapped again and new ticks are merged.
+    const bool is_prefetching = IsPrefetching();
+    StopPrefetching();
+    const bool is_refreshed = LoadNewFramesOfFollowedLogFile();
+    // Playback time is kept by paused prefetcher, so payloads near it are prefetched again without waiting for the next update.
+    if (is_prefetching && StartPrefetching()) {
+        UpdatePlaybackTime(playback_time_s_, is_playing_forward_);
+    }
+    return is_refreshed;
+}
+
+bool BinaryDataLog::LoadNewFramesOfFollowedLogFile() {
+
+    // Map log file again if it grows. Mapping is lazy, so cost of it is not related to size of log file.
+    struct stat file_stat;
+    const std::string log_file_name = mapped_file_r_.file_name();
+    if (::stat(log_file_name.c_str(), &file_stat) != 0 || static_cast<uint64_t>(file_stat.st_size) < index_in_file_of_followed_) {
+        ReportError("[DataLog] Followed log file is removed or truncated : " << log_file_name);
+        is_following_ = false;
+        return false;
+    }
+    if (static_cast<uint64_t>(file_stat.st_size) != mapped_file_r_.size() && !mapped_file_r_.Open(log_file_name)) {
+        ReportError("[DataLog] Cannot open log file : " << log_file_name);
+        is_following_ = false;
+        return false;
+    }
+
+    // Only load complete frames. The last frame may be still being recorded, it will be loaded in next refresh.
+    DecodedPackages decoded_packages;
+    const uint32_t check_size = FrameCheckSize();
+    uint64_t index_in_file = index_in_file_of_followed_;
+    while (mapped_file_r_.IsInside(index_in_file, 4)) {
+        uint32_t offset_to_next_content = 0;
+        std::memcpy(&offset_to_next_content, mapped_file_r_.data() + index_in_file, 4);
+        if (offset_to_next_content < 4 + 2 + 4 + check_size) {
+            ReportError("[DataLog] Offset to next package is broken. Index in file : " << index_in_file << ". Stop following.");
+            is_following_ = false;
+            break;
+        }
+        if (!mapped_file_r_.IsInside(index_in_file, offset_to_next_content)) {
+            break;
+        }
+        // If one package is broken in this file, skip it and continue loading.
+        LoadOnePackage(index_in_file, decoded_packages, follow_dynamic_package_full_data_, true);
+    }
+    index_in_file_of_followed_ = index_in_file;
+
+    // Merge new ticks. Usually they are recorded after all loaded ticks, otherwise packages should be sorted by timestamp again.
+    std::vector<std::tuple<uint16_t, uint32_t, uint32_t>> packages_id_with_new_ticks;
+    bool is_sorting_needed = false;
+    for (const auto &[package_id, package_data]: decoded_packages.packages_id_with_data) {
+        const auto it = packages_id_with_data_.find(package_id);
+        const uint32_t num_of_ticks = it == packages_id_with_data_.end() ? 0 : static_cast<uint32_t>(it->second.size());
+        uint32_t index_of_first_new_tick = num_of_ticks;
+        const auto compare = [](const PackageDataPerTick &tick_a, const PackageDataPerTick &tick_b) { return tick_a.timestamp_s < tick_b.timestamp_s; };
+        const float min_new_timestamp_s = std::min_element(package_data.begin(), package_data.end(), compare)->timestamp_s;
+        if (!std::is_sorted(package_data.begin(), package_data.end(), compare) ||
+            (num_of_ticks > 0 && min_new_timestamp_s < it->second.back().timestamp_s)) {
+            is_sorting_needed = true;
+            if (num_of_ticks > 0) {
+                index_of_first_new_tick = static_cast<uint32_t>(
+                    std::upper_bound(it->second.begin(), it->second.end(), min_new_timestamp_s,
+                                     [](const float timestamp_s, const PackageDataPerTick &tick) { return timestamp_s < tick.timestamp_s; }) -
+                    it->second.begin());
+            }
+        }
+        packages_id_with_new_ticks.emplace_back(package_id, index_of_first_new_tick, static_cast<uint32_t>(package_data.size()));
+        // Loaded ticks after the first new tick are moved by sorting, so pyramids built from them are useless.
+        if (index_of_first_new_tick < num_of_ticks) {
+            packages_id_with_item_pyramids_.erase(package_id);
+        }
+    }
+    for (const auto &[package_id, package_columns]: decoded_packages.packages_id_with_columns) {
+        const auto it = packages_id_with_columns_.find(package_id);
+        const uint32_t num_of_ticks = it == packages_id_with_columns_.end() ? 0 : it->second.size();
+        uint32_t index_of_first_new_tick = num_of_ticks;
+        const auto &new_timestamps_s = package_columns.timestamps_s;
+        const float min_new_timestamp_s = *std::min_element(new_timestamps_s.begin(), new_timestamps_s.end());
+        if (!std::is_sorted(new_timestamps_s.begin(), new_timestamps_s.end()) ||
+            (num_of_ticks > 0 && min_new_timestamp_s < it->second.timestamps_s.back())) {
+            is_sorting_needed = true;
+            if (num_of_ticks > 0) {
+                const auto &timestamps_s = it->second.timestamps_s;
+                index_of_first_new_tick =
+                    static_cast<uint32_t>(std::upper_bound(timestamps_s.begin(), timestamps_s.end(), min_new_timestamp_s) - timestamps_s.begin());
+            }
+        }
+        packages_id_with_new_ticks.emplace_back(package_id, index_of_first_new_tick, package_columns.size());
+        if (index_of_first_new_tick < num_of_ticks) {
+            packages_id_with_item_pyramids_.erase(package_id);
+        }
+    }
+    MergeDecodedPackages(decoded_packages);
+    if (is_sorting_needed) {
+        SortLoadedPackagesByTimestamp();
+    }
+
+    // Notify subscribers after all new ticks are merged.
+    for (const auto &[package_id, index_of_first_new_tick, num_of_new_ticks]: packages_id_with_new_ticks) {
+        for (const auto &subscriber: new_ticks_subscribers_) {
+            subscriber(package_id, index_of_first_new_tick, num_of_new_ticks);
+        }
+    }
+
+    return is_following_;
+}
+
+void BinaryDataLog::SubscribeNewTicks(const NewTicksSubscriber &subscriber) { new_ticks_subscribers_.emplace_back(subscriber); }
+
+}  // namespace slam_data_log
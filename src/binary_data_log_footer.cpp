@@ -0,0 +1,153 @@
+#include "binary_data_log.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "cstring"
+#include "limits"
+
+namespace slam_data_log {
+
+namespace {
+    // Package id, number of package contents, minimum and maximum timestamp.
+    constexpr uint32_t kFooterIndexPackageSize = 2 + 4 + 4 + 4;
+    // Timestamp, index in file and size of all in file.
+    constexpr uint32_t kFooterIndexTickSize = 4 + 8 + 4;
+}  // namespace
+
+bool BinaryDataLog::RecordFooterIndex() {
+    // Statis the whole size of footer index.
+    uint64_t data_size = 2;
+    for (const auto &pair: packages_id_with_index_) {
+        data_size += kFooterIndexPackageSize + pair.second.size() * kFooterIndexTickSize;
+    }
+    data_size += 8 + binary_log_file_footer_index_tail.size();
+    if (4 + 2 + 4 + data_size + FrameCheckSize() > std::numeric_limits<uint32_t>::max()) {
+        ReportWarn("[DataLog] Too many package contents in log file, footer index will not be recorded.");
+        return false;
+    }
+
+    // Build footer index as a frame of reserved package id.
+    const uint64_t index_in_file_of_footer = committed_size_in_file_;
+    char *data_ptr = BeginFrameInStagingBuffer(kFooterIndexPackageId, 0.0f, static_cast<uint32_t>(data_size));
+    const auto write_bytes = [&data_ptr](const void *bytes, const uint32_t size) {
+        std::memcpy(data_ptr, bytes, size);
+        data_ptr += size;
+    };
+
+    const uint16_t num_of_packages = static_cast<uint16_t>(packages_id_with_index_.size());
+    write_bytes(&num_of_packages, 2);
+    for (const auto &[package_id, index_of_ticks]: packages_id_with_index_) {
+        const uint32_t num_of_ticks = static_cast<uint32_t>(index_of_ticks.size());
+        float min_timestamp_s = INFINITY;
+        float max_timestamp_s = -INFINITY;
+        for (const auto &index_per_tick: index_of_ticks) {
+            min_timestamp_s = std::min(min_timestamp_s, index_per_tick.timestamp_s);
+            max_timestamp_s = std::max(max_timestamp_s, index_per_tick.timestamp_s);
+        }
+        write_bytes(&package_id, 2);
+        write_bytes(&num_of_ticks, 4);
+        write_bytes(&min_timestamp_s, 4);
+        write_bytes(&max_timestamp_s, 4);
+
+        for (const auto &index_per_tick: index_of_ticks) {
+            write_bytes(&index_per_tick.timestamp_s, 4);
+            write_bytes(&index_per_tick.index_in_file, 8);
+            write_bytes(&index_per_tick.size_of_all_in_file, 4);
+        }
+    }
+
+    // Fixed tail can be located from the end of log file.
+    write_bytes(&index_in_file_of_footer, 8);
+    write_bytes(binary_log_file_footer_index_tail.data(), binary_log_file_footer_index_tail.size());
+    EndFrameInStagingBuffer(false);
+
+    file_w_ptr_->flush();
+    return file_w_ptr_->good();
+}
+
+bool BinaryDataLog::LoadFooterIndex() {
+    const uint64_t file_size = mapped_file_r_.size();
+
+    // Locate footer index by the fixed tail.
+    const uint32_t check_size = FrameCheckSize();
+    const uint32_t tail_size = 8 + binary_log_file_footer_index_tail.size() + check_size;
+    RETURN_FALSE_IF(file_size < tail_size);
+    const uint8_t *tail_ptr = mapped_file_r_.data() + file_size - tail_size;
+    uint64_t index_in_file_of_footer = 0;
+    std::memcpy(&index_in_file_of_footer, tail_ptr, 8);
+    RETURN_FALSE_IF(std::memcmp(tail_ptr + 8, binary_log_file_footer_index_tail.data(), binary_log_file_footer_index_tail.size()) != 0);
+    RETURN_FALSE_IF(index_in_file_of_footer < index_in_file_of_content_);
+    RETURN_FALSE_IF(index_in_file_of_footer + 4 + 2 + 4 + 2 + tail_size > file_size);
+
+    // Check the whole footer index in mapped log file.
+    const uint64_t footer_size = file_size - index_in_file_of_footer;
+    RETURN_FALSE_IF(footer_size > std::numeric_limits<uint32_t>::max());
+    const uint8_t *footer_ptr = mapped_file_r_.data() + index_in_file_of_footer;
+
+    uint32_t offset_to_next_content = 0;
+    uint16_t footer_package_id = 0;
+    uint32_t loaded_check_value = 0;
+    std::memcpy(&offset_to_next_content, footer_ptr, 4);
+    std::memcpy(&footer_package_id, footer_ptr + 4, 2);
+    std::memcpy(&loaded_check_value, footer_ptr + footer_size - check_size, check_size);
+    RETURN_FALSE_IF(offset_to_next_content != footer_size || footer_package_id != kFooterIndexPackageId);
+    if (UpdateFrameCheckValue(footer_ptr, footer_size - check_size, 0) != loaded_check_value) {
+        ReportWarn("[DataLog] Footer index summary check error.");
+        return false;
+    }
+
+    // Parse index of all packages.
+    const uint8_t *data_ptr = footer_ptr + 4 + 2 + 4;
+    const uint8_t *data_end_ptr = footer_ptr + footer_size - tail_size;
+    const auto read_bytes = [&data_ptr](void *bytes, const uint32_t size) {
+        std::memcpy(bytes, data_ptr, size);
+        data_ptr += size;
+    };
+
+    std::unordered_map<uint16_t, std::vector<PackageDataPerTick>> packages_id_with_data;
+    std::pair<float, float> timestamp_s_range = std::make_pair(INFINITY, -INFINITY);
+    uint16_t num_of_packages = 0;
+    read_bytes(&num_of_packages, 2);
+    for (uint16_t i = 0; i < num_of_packages; ++i) {
+        RETURN_FALSE_IF(data_ptr + kFooterIndexPackageSize > data_end_ptr);
+        uint16_t package_id = 0;
+        uint32_t num_of_ticks = 0;
+        float min_timestamp_s = 0.0f;
+        float max_timestamp_s = 0.0f;
+        read_bytes(&package_id, 2);
+        read_bytes(&num_of_ticks, 4);
+        read_bytes(&min_timestamp_s, 4);
+        read_bytes(&max_timestamp_s, 4);
+        RETURN_FALSE_IF(static_cast<uint64_t>(num_of_ticks) * kFooterIndexTickSize > static_cast<uint64_t>(data_end_ptr - data_ptr));
+
+        // Index of unregistered package is useless.
+        if (packages_id_with_objects_.find(package_id) == packages_id_with_objects_.end()) {
+            ReportWarn("[DataLog] Package id " << package_id << " in footer index is not registered.");
+            data_ptr += num_of_ticks * kFooterIndexTickSize;
+            continue;
+        }
+        if (!IsPackageSelectedToLoad(package_id)) {
+            data_ptr += num_of_ticks * kFooterIndexTickSize;
+            continue;
+        }
+
+        auto &packages = packages_id_with_data[package_id];
+        packages.resize(num_of_ticks);
+        for (auto &timestamped_data: packages) {
+            read_bytes(&timestamped_data.timestamp_s, 4);
+            read_bytes(&timestamped_data.index_in_file, 8);
+            read_bytes(&timestamped_data.size_of_all_in_file, 4);
+        }
+        if (num_of_ticks > 0) {
+            timestamp_s_range.first = std::min(timestamp_s_range.first, min_timestamp_s);
+            timestamp_s_range.second = std::max(timestamp_s_range.second, max_timestamp_s);
+        }
+    }
+    RETURN_FALSE_IF(data_ptr != data_end_ptr);
+
+    packages_id_with_data_ = std::move(packages_id_with_data);
+    timestamp_s_range_of_loaded_log_ = timestamp_s_range;
+    return true;
+}
+
+}  // namespace slam_data_log
@@ -0,0 +1,98 @@
+#include "binary_data_log_item_pyramid.h"
+#include "slam_operations.h"
+
+#include "algorithm"
+
+namespace slam_data_log {
+
+void BinaryDataLogItemPyramid::Append(const float *timestamps_s, const float *values, const uint32_t num_of_samples) {
+    RETURN_IF(num_of_samples == 0);
+    if (levels_.empty()) {
+        levels_.emplace_back();
+    }
+
+    // Samples are merged into buckets of level 0. The last bucket is merged again from its samples if it is not full.
+    std::vector<TimeSeriesBucket> &first_level = levels_.front();
+    uint64_t index_of_first_changed_bucket = num_of_samples_ / kBranchFactor;
+    for (uint32_t i = 0; i < num_of_samples; ++i) {
+        if (samples_of_last_bucket_.size() == kBranchFactor) {
+            samples_of_last_bucket_.clear();
+        }
+        samples_of_last_bucket_.emplace_back(TimeSeriesBucket {
+            .timestamp_s_begin = timestamps_s[i],
+            .timestamp_s_end = timestamps_s[i],
+            .min_value = values[i],
+            .max_value = values[i],
+            .mean_value = values[i],
+            .num_of_samples = 1,
+        });
+        ++num_of_samples_;
+        CONTINUE_IF(samples_of_last_bucket_.size() < kBranchFactor && i + 1 < num_of_samples);
+        const TimeSeriesBucket bucket = MergeBuckets(samples_of_last_bucket_.data(), static_cast<uint32_t>(samples_of_last_bucket_.size()));
+        const uint64_t index_of_bucket = (num_of_samples_ - 1) / kBranchFactor;
+        if (index_of_bucket < first_level.size()) {
+            first_level[index_of_bucket] = bucket;
+        } else {
+            first_level.emplace_back(bucket);
+        }
+    }
+
+    // Merge changed buckets level by level, until only one bucket is left.
+    for (uint32_t i = 1; levels_[i - 1].size() > 1; ++i) {
+        if (i == levels_.size()) {
+            levels_.emplace_back();
+        }
+        const std::vector<TimeSeriesBucket> &lower_level = levels_[i - 1];
+        std::vector<TimeSeriesBucket> &upper_level = levels_[i];
+        index_of_first_changed_bucket /= kBranchFactor;
+        upper_level.resize(index_of_first_changed_bucket);
+        for (uint64_t j = index_of_first_changed_bucket * kBranchFactor; j < lower_level.size(); j += kBranchFactor) {
+            upper_level.emplace_back(MergeBuckets(lower_level.data() + j, static_cast<uint32_t>(std::min<uint64_t>(kBranchFactor, lower_level.size() - j))));
+        }
+    }
+}
+
+void BinaryDataLogItemPyramid::Clear() {
+    levels_.clear();
+    samples_of_last_bucket_.clear();
+    num_of_samples_ = 0;
+}
+
+void BinaryDataLogItemPyramid::Query(const float time_stamp_s_begin, const float time_stamp_s_end, const uint64_t num_of_samples_in_range,
+                                     const uint32_t num_of_buckets, std::vector<TimeSeriesBucket> &buckets) const {
+    buckets.clear();
+    RETURN_IF(levels_.empty() || time_stamp_s_begin > time_stamp_s_end);
+
+    // Decide level by number of samples in time range.
+    const auto is_end_before = [](const TimeSeriesBucket &bucket, const float time_stamp_s) { return bucket.timestamp_s_end < time_stamp_s; };
+    const auto is_after_begin = [](const float time_stamp_s, const TimeSeriesBucket &bucket) { return time_stamp_s < bucket.timestamp_s_begin; };
+    uint32_t index_of_level = 0;
+    uint64_t size_of_upper_bucket = kBranchFactor * kBranchFactor;
+    while (index_of_level + 1 < levels_.size() && num_of_samples_in_range / size_of_upper_bucket >= num_of_buckets) {
+        ++index_of_level;
+        size_of_upper_bucket *= kBranchFactor;
+    }
+
+    const std::vector<TimeSeriesBucket> &level = levels_[index_of_level];
+    const auto begin_it = std::lower_bound(level.begin(), level.end(), time_stamp_s_begin, is_end_before);
+    const auto end_it = std::upper_bound(level.begin(), level.end(), time_stamp_s_end, is_after_begin);
+    if (begin_it < end_it) {
+        buckets.assign(begin_it, end_it);
+    }
+}
+
+TimeSeriesBucket BinaryDataLogItemPyramid::MergeBuckets(const TimeSeriesBucket *buckets, const uint32_t num_of_buckets) {
+    TimeSeriesBucket merged_bucket = buckets[0];
+    double sum_of_values = static_cast<double>(buckets[0].mean_value) * buckets[0].num_of_samples;
+    for (uint32_t i = 1; i < num_of_buckets; ++i) {
+        merged_bucket.timestamp_s_end = buckets[i].timestamp_s_end;
+        merged_bucket.min_value = std::min(merged_bucket.min_value, buckets[i].min_value);
+        merged_bucket.max_value = std::max(merged_bucket.max_value, buckets[i].max_value);
+        merged_bucket.num_of_samples += buckets[i].num_of_samples;
+        sum_of_values += static_cast<double>(buckets[i].mean_value) * buckets[i].num_of_samples;
+    }
+    merged_bucket.mean_value = static_cast<float>(sum_of_values / merged_bucket.num_of_samples);
+    return merged_bucket;
+}
+
+}  // namespace slam_data_log
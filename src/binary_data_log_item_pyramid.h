@@ -0,0 +1,61 @@
+#ifndef _BINARY_DATA_LOG_ITEM_PYRAMID_H_
+#define _BINARY_DATA_LOG_ITEM_PYRAMID_H_
+
+#include "basic_type.h"
+
+#include "vector"
+
+namespace slam_data_log {
+
+// Summary of samples of one item component in a time bucket.
+struct TimeSeriesBucket {
+    float timestamp_s_begin = 0.0f;  // Timestamp of the first sample.
+    float timestamp_s_end = 0.0f;    // Timestamp of the last sample.
+    float min_value = 0.0f;
+    float max_value = 0.0f;
+    float mean_value = 0.0f;
+    uint32_t num_of_samples = 0;
+};
+
+/* Class BinaryDataLogItemPyramid Declaration. */
+// Level of detail of one item component. Each bucket of level 0 merges kBranchFactor samples, and each bucket of upper level merges
+// kBranchFactor buckets of the level below. Samples are not stored, so queries finer than level 0 should be answered by samples.
+// Samples should be appended in timestamp order.
+class BinaryDataLogItemPyramid {
+
+public:
+    static constexpr uint32_t kBranchFactor = 4;
+
+public:
+    BinaryDataLogItemPyramid() = default;
+    virtual ~BinaryDataLogItemPyramid() = default;
+
+    // Only the last bucket of each level and new buckets are updated.
+    void Append(const float *timestamps_s, const float *values, const uint32_t num_of_samples);
+    void Clear();
+    // Level 0 has fewer than 'num_of_buckets' buckets for so many samples, then samples should be used as buckets.
+    static bool IsFinerThanLevels(const uint64_t num_of_samples_in_range, const uint32_t num_of_buckets) {
+        return num_of_samples_in_range / kBranchFactor < num_of_buckets;
+    }
+    // Buckets of the coarsest level which still has at least 'num_of_buckets' buckets in [time_stamp_s_begin, time_stamp_s_end], which
+    // has 'num_of_samples_in_range' samples. Buckets partially in time range are included.
+    void Query(const float time_stamp_s_begin, const float time_stamp_s_end, const uint64_t num_of_samples_in_range, const uint32_t num_of_buckets,
+               std::vector<TimeSeriesBucket> &buckets) const;
+
+    uint32_t num_of_samples() const { return num_of_samples_; }
+    uint32_t num_of_levels() const { return static_cast<uint32_t>(levels_.size()); }
+    const std::vector<TimeSeriesBucket> &level(const uint32_t index_of_level) const { return levels_[index_of_level]; }
+
+private:
+    static TimeSeriesBucket MergeBuckets(const TimeSeriesBucket *buckets, const uint32_t num_of_buckets);
+
+private:
+    std::vector<std::vector<TimeSeriesBucket>> levels_;
+    // Samples of the last bucket of level 0, which is merged again if it is not full.
+    std::vector<TimeSeriesBucket> samples_of_last_bucket_;
+    uint32_t num_of_samples_ = 0;
+};
+
+}  // namespace slam_data_log
+
+#endif  // end of _BINARY_DATA_LOG_ITEM_PYRAMID_H_
@@ -0,0 +1,86 @@
+#include "binary_data_log.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+namespace slam_data_log {
+
+bool BinaryDataLog::BuildItemPyramids(const uint16_t package_id, const std::string &item_name) {
+    // All loaded ticks are in infinite time range.
+    uint32_t index_of_begin_tick = 0;
+    uint32_t num_of_ticks = 0;
+    RETURN_FALSE_IF_FALSE(Query(package_id, -INFINITY, INFINITY, index_of_begin_tick, num_of_ticks));
+
+    // Ticks appended by follower are appended into pyramids, so only new ticks are extracted. Otherwise pyramids are built again.
+    std::vector<BinaryDataLogItemPyramid> &pyramids = packages_id_with_item_pyramids_[package_id][item_name];
+    if (!pyramids.empty() && pyramids.front().num_of_samples() > num_of_ticks) {
+        pyramids.clear();
+    }
+    const uint32_t index_of_first_new_tick = pyramids.empty() ? 0 : pyramids.front().num_of_samples();
+    std::vector<float> timestamps_s;
+    std::vector<std::vector<float>> columns;
+    if (!ExtractTimestampColumn(package_id, index_of_first_new_tick, num_of_ticks, timestamps_s) ||
+        !ExtractItemColumns(package_id, item_name, index_of_first_new_tick, num_of_ticks, columns) || num_of_ticks == 0) {
+        ReportError("[DataLog] Cannot build pyramids of item [" << item_name << "] in package [id][" << package_id << "].");
+        packages_id_with_item_pyramids_[package_id].erase(item_name);
+        return false;
+    }
+    if (pyramids.size() != columns.size()) {
+        pyramids.assign(columns.size(), BinaryDataLogItemPyramid());
+    }
+    for (uint32_t i = 0; i < pyramids.size(); ++i) {
+        pyramids[i].Append(timestamps_s.data(), columns[i].data(), timestamps_s.size());
+    }
+    return true;
+}
+
+bool BinaryDataLog::QueryItemBuckets(const uint16_t package_id, const std::string &item_name, const float time_stamp_s_begin,
+                                     const float time_stamp_s_end, const uint32_t num_of_buckets,
+                                     std::vector<std::vector<TimeSeriesBucket>> &buckets_of_components) {
+    buckets_of_components.clear();
+    // All loaded ticks are in infinite time range.
+    uint32_t index_of_begin_tick = 0;
+    uint32_t num_of_ticks = 0;
+    RETURN_FALSE_IF_FALSE(Query(package_id, -INFINITY, INFINITY, index_of_begin_tick, num_of_ticks));
+
+    // Pyramids are built by the first query, and updated if more ticks are loaded.
+    const auto package_it = packages_id_with_item_pyramids_.find(package_id);
+    const bool is_pyramid_built = package_it != packages_id_with_item_pyramids_.end() && package_it->second.count(item_name) != 0;
+    if (!is_pyramid_built || packages_id_with_item_pyramids_[package_id][item_name].front().num_of_samples() != num_of_ticks) {
+        RETURN_FALSE_IF_FALSE(BuildItemPyramids(package_id, item_name));
+    }
+
+    // Few ticks in time range are summarized by themselves, one bucket per tick.
+    uint32_t index_of_end_tick = 0;
+    RETURN_FALSE_IF_FALSE(Query(package_id, time_stamp_s_begin, time_stamp_s_end, index_of_begin_tick, index_of_end_tick));
+    const uint64_t num_of_ticks_in_range = index_of_end_tick - index_of_begin_tick;
+    if (BinaryDataLogItemPyramid::IsFinerThanLevels(num_of_ticks_in_range, num_of_buckets)) {
+        std::vector<float> timestamps_s;
+        std::vector<std::vector<float>> columns;
+        RETURN_FALSE_IF(!ExtractTimestampColumn(package_id, index_of_begin_tick, index_of_end_tick, timestamps_s) ||
+                        !ExtractItemColumns(package_id, item_name, index_of_begin_tick, index_of_end_tick, columns));
+        buckets_of_components.resize(columns.size());
+        for (uint32_t i = 0; i < columns.size(); ++i) {
+            buckets_of_components[i].reserve(timestamps_s.size());
+            for (uint32_t j = 0; j < timestamps_s.size(); ++j) {
+                buckets_of_components[i].emplace_back(TimeSeriesBucket {
+                    .timestamp_s_begin = timestamps_s[j],
+                    .timestamp_s_end = timestamps_s[j],
+                    .min_value = columns[i][j],
+                    .max_value = columns[i][j],
+                    .mean_value = columns[i][j],
+                    .num_of_samples = 1,
+                });
+            }
+        }
+        return true;
+    }
+
+    const std::vector<BinaryDataLogItemPyramid> &pyramids = packages_id_with_item_pyramids_[package_id][item_name];
+    buckets_of_components.resize(pyramids.size());
+    for (uint32_t i = 0; i < pyramids.size(); ++i) {
+        pyramids[i].Query(time_stamp_s_begin, time_stamp_s_end, num_of_ticks_in_range, num_of_buckets, buckets_of_components[i]);
+    }
+    return true;
+}
+
+}  // namespace slam_data_log
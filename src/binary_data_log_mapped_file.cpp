@@ -0,0 +1,80 @@
+#include "binary_data_log_mapped_file.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "fcntl.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+#include "unistd.h"
+
+namespace slam_data_log {
+
+BinaryDataLogMappedFile::~BinaryDataLogMappedFile() { Close(); }
+
+bool BinaryDataLogMappedFile::Open(const std::string &file_name) {
+    Close();
+
+    file_descriptor_ = ::open(file_name.c_str(), O_RDONLY);
+    if (file_descriptor_ < 0) {
+        ReportError("[DataLog] Cannot open file to be mapped : " << file_name);
+        return false;
+    }
+
+    struct stat file_stat;
+    if (::fstat(file_descriptor_, &file_stat) != 0) {
+        ReportError("[DataLog] Cannot get size of file to be mapped : " << file_name);
+        Close();
+        return false;
+    }
+
+    // Empty file cannot be mapped, but it is still a valid file.
+    file_name_ = file_name;
+    size_ = static_cast<uint64_t>(file_stat.st_size);
+    modified_time_ns_ = static_cast<uint64_t>(file_stat.st_mtim.tv_sec) * 1000000000 + static_cast<uint64_t>(file_stat.st_mtim.tv_nsec);
+    if (size_ == 0) {
+        return true;
+    }
+
+    void *data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, file_descriptor_, 0);
+    if (data == MAP_FAILED) {
+        ReportError("[DataLog] Cannot map file : " << file_name);
+        Close();
+        return false;
+    }
+    data_ = static_cast<const uint8_t *>(data);
+
+    return true;
+}
+
+void BinaryDataLogMappedFile::AdviseSequentialAccess() const {
+    if (data_ != nullptr) {
+        ::madvise(const_cast<uint8_t *>(data_), size_, MADV_SEQUENTIAL);
+    }
+}
+
+void BinaryDataLogMappedFile::ReleasePages(const uint64_t index, const uint64_t size) const {
+    RETURN_IF(data_ == nullptr || !IsInside(index, size));
+    // Only whole pages inside of [index, index + size) can be released.
+    const uint64_t page_size = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+    const uint64_t begin = (index + page_size - 1) / page_size * page_size;
+    const uint64_t end = (index + size) / page_size * page_size;
+    if (begin < end) {
+        ::madvise(const_cast<uint8_t *>(data_) + begin, end - begin, MADV_DONTNEED);
+    }
+}
+
+void BinaryDataLogMappedFile::Close() {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<uint8_t *>(data_), size_);
+    }
+    if (file_descriptor_ >= 0) {
+        ::close(file_descriptor_);
+    }
+    file_name_.clear();
+    file_descriptor_ = -1;
+    data_ = nullptr;
+    size_ = 0;
+    modified_time_ns_ = 0;
+}
+
+}  // namespace slam_data_log
@@ -0,0 +1,44 @@
+#ifndef _BINARY_DATA_LOG_MAPPED_FILE_H_
+#define _BINARY_DATA_LOG_MAPPED_FILE_H_
+
+#include "basic_type.h"
+#include "string"
+
+namespace slam_data_log {
+
+/* Class BinaryDataLogMappedFile Declaration. */
+class BinaryDataLogMappedFile {
+
+public:
+    BinaryDataLogMappedFile() = default;
+    virtual ~BinaryDataLogMappedFile();
+    BinaryDataLogMappedFile(const BinaryDataLogMappedFile &) = delete;
+    BinaryDataLogMappedFile &operator=(const BinaryDataLogMappedFile &) = delete;
+
+    bool Open(const std::string &file_name);
+    void Close();
+    bool IsOpen() const { return file_descriptor_ >= 0; }
+    // Check if [index, index + size) is inside of mapped file.
+    bool IsInside(const uint64_t index, const uint64_t size) const { return index <= size_ && size <= size_ - index; }
+
+    // Support for streaming. Pages which have been visited can be released, so memory is bounded for file larger than RAM.
+    void AdviseSequentialAccess() const;
+    void ReleasePages(const uint64_t index, const uint64_t size) const;
+
+    // Const Reference for member variables.
+    const std::string &file_name() const { return file_name_; }
+    const uint8_t *data() const { return data_; }
+    const uint64_t &size() const { return size_; }
+    const uint64_t &modified_time_ns() const { return modified_time_ns_; }
+
+private:
+    std::string file_name_;
+    int32_t file_descriptor_ = -1;
+    const uint8_t *data_ = nullptr;
+    uint64_t size_ = 0;
+    uint64_t modified_time_ns_ = 0;
+};
+
+}  // namespace slam_data_log
+
+#endif  // end of _BINARY_DATA_LOG_MAPPED_FILE_H_
@@ -0,0 +1,82 @@
+#include "binary_data_log_payload_cache.h"
+#include "slam_operations.h"
+
+namespace slam_data_log {
+
+BinaryDataView BinaryDataLogPayloadCache::Find(const uint64_t index_in_file, const uint32_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = index_in_file_with_items_.find(index_in_file);
+    if (it == index_in_file_with_items_.end() || it->second->view.size() != size) {
+        ++statistics_.num_of_misses;
+        return BinaryDataView();
+    }
+
+    // Move this item to front as the most recently used one.
+    cached_items_.splice(cached_items_.begin(), cached_items_, it->second);
+    ++statistics_.num_of_hits;
+    return it->second->view;
+}
+
+bool BinaryDataLogPayloadCache::Touch(const uint64_t index_in_file, const uint32_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = index_in_file_with_items_.find(index_in_file);
+    RETURN_FALSE_IF(it == index_in_file_with_items_.end() || it->second->view.size() != size);
+    cached_items_.splice(cached_items_.begin(), cached_items_, it->second);
+    return true;
+}
+
+void BinaryDataLogPayloadCache::Insert(const uint64_t index_in_file, const BinaryDataView &view) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Data larger than budget is not cached, otherwise all other items will be evicted.
+    if (view.size() > size_budget_) {
+        return;
+    }
+
+    const auto it = index_in_file_with_items_.find(index_in_file);
+    if (it != index_in_file_with_items_.end()) {
+        statistics_.size_of_cached_bytes -= it->second->view.size();
+        cached_items_.erase(it->second);
+        index_in_file_with_items_.erase(it);
+    }
+    cached_items_.emplace_front(CachedItem {.index_in_file = index_in_file, .view = view});
+    index_in_file_with_items_[index_in_file] = cached_items_.begin();
+    statistics_.size_of_cached_bytes += view.size();
+    EvictUntilInBudget();
+}
+
+void BinaryDataLogPayloadCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cached_items_.clear();
+    index_in_file_with_items_.clear();
+    statistics_ = Statistics();
+}
+
+void BinaryDataLogPayloadCache::SetSizeBudget(const uint64_t size_budget) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_budget_ = size_budget;
+    EvictUntilInBudget();
+}
+
+uint64_t BinaryDataLogPayloadCache::size_budget() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_budget_;
+}
+
+BinaryDataLogPayloadCache::Statistics BinaryDataLogPayloadCache::statistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Statistics statistics = statistics_;
+    statistics.num_of_cached_items = cached_items_.size();
+    return statistics;
+}
+
+void BinaryDataLogPayloadCache::EvictUntilInBudget() {
+    // Evicted data is still alive if it is viewed by others.
+    while (statistics_.size_of_cached_bytes > size_budget_ && !cached_items_.empty()) {
+        statistics_.size_of_cached_bytes -= cached_items_.back().view.size();
+        index_in_file_with_items_.erase(cached_items_.back().index_in_file);
+        cached_items_.pop_back();
+        ++statistics_.num_of_evictions;
+    }
+}
+
+}  // namespace slam_data_log
@@ -0,0 +1,83 @@
+#ifndef _BINARY_DATA_LOG_PAYLOAD_CACHE_H_
+#define _BINARY_DATA_LOG_PAYLOAD_CACHE_H_
+
+#include "basic_type.h"
+
+#include "list"
+#include "memory"
+#include "mutex"
+#include "unordered_map"
+#include "vector"
+
+namespace slam_data_log {
+
+/* Class BinaryDataView Declaration. */
+// View of binary data in log file. Bytes are shared by all views and kept alive until the last view is destroyed.
+class BinaryDataView {
+
+public:
+    BinaryDataView() = default;
+    explicit BinaryDataView(std::shared_ptr<const std::vector<uint8_t>> bytes) : bytes_(std::move(bytes)) {}
+    virtual ~BinaryDataView() = default;
+
+    bool empty() const { return size() == 0; }
+    const uint8_t *data() const { return bytes_ == nullptr ? nullptr : bytes_->data(); }
+    uint32_t size() const { return bytes_ == nullptr ? 0 : static_cast<uint32_t>(bytes_->size()); }
+    const uint8_t *begin() const { return data(); }
+    const uint8_t *end() const { return data() + size(); }
+
+private:
+    std::shared_ptr<const std::vector<uint8_t>> bytes_ = nullptr;
+};
+
+/* Class BinaryDataLogPayloadCache Declaration. */
+// Least recently used binary data in log file, limited by size of cached bytes. It can be used by multiple threads.
+class BinaryDataLogPayloadCache {
+
+public:
+    static constexpr uint64_t kDefaultSizeBudget = 256 * 1024 * 1024;
+
+    struct Statistics {
+        uint64_t num_of_hits = 0;
+        uint64_t num_of_misses = 0;
+        uint64_t num_of_evictions = 0;
+        uint64_t size_of_cached_bytes = 0;
+        uint64_t num_of_cached_items = 0;
+    };
+
+public:
+    BinaryDataLogPayloadCache() = default;
+    virtual ~BinaryDataLogPayloadCache() = default;
+
+    // Return empty view and count a miss if not cached.
+    BinaryDataView Find(const uint64_t index_in_file, const uint32_t size);
+    void Insert(const uint64_t index_in_file, const BinaryDataView &view);
+    // Mark as the most recently used one if cached, without counting a hit or miss.
+    bool Touch(const uint64_t index_in_file, const uint32_t size);
+    void Clear();
+    void SetSizeBudget(const uint64_t size_budget);
+
+    uint64_t size_budget() const;
+    Statistics statistics() const;
+
+private:
+    struct CachedItem {
+        uint64_t index_in_file = 0;
+        BinaryDataView view;
+    };
+
+private:
+    void EvictUntilInBudget();
+
+private:
+    mutable std::mutex mutex_;
+    uint64_t size_budget_ = kDefaultSizeBudget;
+    // The most recently used item is at front.
+    std::list<CachedItem> cached_items_;
+    std::unordered_map<uint64_t, std::list<CachedItem>::iterator> index_in_file_with_items_;
+    Statistics statistics_;
+};
+
+}  // namespace slam_data_log
+
+#endif  // end of _BINARY_DATA_LOG_PAYLOAD_CACHE_H_
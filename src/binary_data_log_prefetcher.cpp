@@ -0,0 +1,126 @@
+#include "binary_data_log.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "algorithm"
+#include "cmath"
+
+namespace slam_data_log {
+
+bool BinaryDataLog::StartPrefetching() {
+    if (IsPrefetching()) {
+        ReportWarn("[DataLog] Prefetcher is already started.");
+        return true;
+    }
+    if (!mapped_file_r_.IsOpen()) {
+        ReportError("[DataLog] Log file is not loaded, cannot start prefetcher.");
+        return false;
+    }
+
+    // Only packages with dynamic size are prefetched, others are all loaded.
+    prefetcher_package_ids_.clear();
+    for (const auto &pair: packages_id_with_data_) {
+        const auto it = packages_id_with_objects_.find(pair.first);
+        if (it != packages_id_with_objects_.end() && it->second->size == 0 &&
+            (package_ids_to_prefetch_.empty() || package_ids_to_prefetch_.count(pair.first) != 0)) {
+            prefetcher_package_ids_.emplace_back(pair.first);
+        }
+    }
+    // Payloads prefetched should not evict each other.
+    prefetcher_window_s_ = prefetch_window_s_;
+    prefetcher_window_size_ = std::min(prefetch_window_size_, payload_cache_.size_budget());
+
+    prefetcher_stop_ = false;
+    prefetcher_idle_ = true;
+    has_new_playback_time_ = false;
+    prefetcher_thread_ = std::thread(&BinaryDataLog::PrefetcherLoop, this);
+    return true;
+}
+
+void BinaryDataLog::StopPrefetching() {
+    RETURN_IF(!IsPrefetching());
+    {
+        std::lock_guard<std::mutex> lock(prefetcher_mutex_);
+        prefetcher_stop_ = true;
+    }
+    prefetcher_signal_.notify_one();
+    prefetcher_thread_.join();
+}
+
+void BinaryDataLog::UpdatePlaybackTime(const float playback_time_s, const bool is_playing_forward) {
+    RETURN_IF(!IsPrefetching());
+    {
+        std::lock_guard<std::mutex> lock(prefetcher_mutex_);
+        playback_time_s_ = playback_time_s;
+        is_playing_forward_ = is_playing_forward;
+        has_new_playback_time_ = true;
+        prefetcher_idle_ = false;
+    }
+    prefetcher_signal_.notify_one();
+}
+
+void BinaryDataLog::WaitForPrefetching() {
+    RETURN_IF(!IsPrefetching());
+    std::unique_lock<std::mutex> lock(prefetcher_mutex_);
+    prefetcher_idle_signal_.wait(lock, [this]() { return prefetcher_idle_; });
+}
+
+void BinaryDataLog::PrefetcherLoop() {
+    while (true) {
+        float playback_time_s = 0.0f;
+        bool is_playing_forward = true;
+        {
+            std::unique_lock<std::mutex> lock(prefetcher_mutex_);
+            if (!has_new_playback_time_) {
+                prefetcher_idle_ = true;
+                prefetcher_idle_signal_.notify_all();
+            }
+            prefetcher_signal_.wait(lock, [this]() { return prefetcher_stop_ || has_new_playback_time_; });
+            if (prefetcher_stop_) {
+                prefetcher_idle_ = true;
+                prefetcher_idle_signal_.notify_all();
+                return;
+            }
+            playback_time_s = playback_time_s_;
+            is_playing_forward = is_playing_forward_;
+            has_new_playback_time_ = false;
+        }
+        PrefetchPayloadsNearPlaybackTime(playback_time_s, is_playing_forward);
+    }
+}
+
+void BinaryDataLog::PrefetchPayloadsNearPlaybackTime(const float playback_time_s, const bool is_playing_forward) {
+    // Collect ticks in time window of all packages to prefetch.
+    const float time_stamp_s_begin = is_playing_forward ? playback_time_s : playback_time_s - prefetcher_window_s_;
+    const float time_stamp_s_end = is_playing_forward ? playback_time_s + prefetcher_window_s_ : playback_time_s;
+    std::vector<const PackageDataPerTick *> ticks;
+    for (const uint16_t package_id: prefetcher_package_ids_) {
+        uint32_t index_of_begin_tick = 0;
+        uint32_t index_of_end_tick = 0;
+        CONTINUE_IF(!Query(package_id, time_stamp_s_begin, time_stamp_s_end, index_of_begin_tick, index_of_end_tick));
+        const auto &package_data = packages_id_with_data_.at(package_id);
+        for (uint32_t i = index_of_begin_tick; i < index_of_end_tick; ++i) {
+            ticks.emplace_back(&package_data[i]);
+        }
+    }
+
+    // Ticks which will be played earlier are prefetched earlier.
+    std::sort(ticks.begin(), ticks.end(), [playback_time_s](const PackageDataPerTick *tick_a, const PackageDataPerTick *tick_b) {
+        return std::fabs(tick_a->timestamp_s - playback_time_s) < std::fabs(tick_b->timestamp_s - playback_time_s);
+    });
+    uint64_t size_of_prefetched = 0;
+    for (const auto tick: ticks) {
+        // Playback time has changed, so these ticks may be useless.
+        RETURN_IF(has_new_playback_time_ || prefetcher_stop_);
+        size_of_prefetched += tick->size_of_all_in_file;
+        RETURN_IF(size_of_prefetched > prefetcher_window_size_);
+        if (!payload_cache_.Touch(tick->index_in_file, tick->size_of_all_in_file)) {
+            const BinaryDataView view = CopyBinaryDataViewFromLogFile(tick->index_in_file, tick->size_of_all_in_file);
+            if (!view.empty()) {
+                payload_cache_.Insert(tick->index_in_file, view);
+            }
+        }
+    }
+}
+
+}  // namespace slam_data_log
@@ -0,0 +1,140 @@
+#include "binary_data_log.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "algorithm"
+#include "numeric"
+
+namespace slam_data_log {
+
+namespace {
+    float TimestampOfTick(const PackageDataPerTick &tick) { return tick.timestamp_s; }
+    float TimestampOfTick(const float timestamp_s) { return timestamp_s; }
+
+    // Ticks with timestamp in [time_stamp_s_begin, time_stamp_s_end] are [index_of_begin_tick, index_of_end_tick).
+    template <typename TickT>
+    void QueryTicksInSortedVector(const std::vector<TickT> &ticks, const float time_stamp_s_begin, const float time_stamp_s_end,
+                                  uint32_t &index_of_begin_tick, uint32_t &index_of_end_tick) {
+        const auto begin_it = std::lower_bound(ticks.begin(), ticks.end(), time_stamp_s_begin,
+                                               [](const TickT &tick, const float time_stamp_s) { return TimestampOfTick(tick) < time_stamp_s; });
+        const auto end_it = std::upper_bound(begin_it, ticks.end(), time_stamp_s_end,
+                                             [](const float time_stamp_s, const TickT &tick) { return time_stamp_s < TimestampOfTick(tick); });
+        index_of_begin_tick = static_cast<uint32_t>(begin_it - ticks.begin());
+        index_of_end_tick = static_cast<uint32_t>(std::max(begin_it, end_it) - ticks.begin());
+    }
+
+    // If two ticks are as near as each other, the earlier one is chosen.
+    template <typename TickT>
+    uint32_t QueryNearestTickInSortedVector(const std::vector<TickT> &ticks, const float time_stamp_s) {
+        const auto it = std::lower_bound(ticks.begin(), ticks.end(), time_stamp_s,
+                                         [](const TickT &tick, const float time_stamp_s) { return TimestampOfTick(tick) < time_stamp_s; });
+        if (it == ticks.begin()) {
+            return 0;
+        }
+        if (it == ticks.end() || time_stamp_s - TimestampOfTick(*(it - 1)) <= TimestampOfTick(*it) - time_stamp_s) {
+            return static_cast<uint32_t>(it - ticks.begin() - 1);
+        }
+        return static_cast<uint32_t>(it - ticks.begin());
+    }
+}  // namespace
+
+bool BinaryDataLog::Query(const uint16_t package_id, const float time_stamp_s_begin, const float time_stamp_s_end, uint32_t &index_of_begin_tick,
+                          uint32_t &index_of_end_tick) const {
+    index_of_begin_tick = 0;
+    index_of_end_tick = 0;
+    const auto data_it = packages_id_with_data_.find(package_id);
+    if (data_it != packages_id_with_data_.end()) {
+        QueryTicksInSortedVector(data_it->second, time_stamp_s_begin, time_stamp_s_end, index_of_begin_tick, index_of_end_tick);
+        return true;
+    }
+    const auto columns_it = packages_id_with_columns_.find(package_id);
+    if (columns_it != packages_id_with_columns_.end()) {
+        QueryTicksInSortedVector(columns_it->second.timestamps_s, time_stamp_s_begin, time_stamp_s_end, index_of_begin_tick, index_of_end_tick);
+        return true;
+    }
+    ReportError("[DataLog] Package id " << package_id << " is not loaded.");
+    return false;
+}
+
+bool BinaryDataLog::Query(const uint16_t package_id, const float time_stamp_s_begin, const float time_stamp_s_end,
+                          std::vector<PackageDataPerTick> &ticks) const {
+    ticks.clear();
+    uint32_t index_of_begin_tick = 0;
+    uint32_t index_of_end_tick = 0;
+    RETURN_FALSE_IF_FALSE(Query(package_id, time_stamp_s_begin, time_stamp_s_end, index_of_begin_tick, index_of_end_tick));
+
+    const auto data_it = packages_id_with_data_.find(package_id);
+    if (data_it != packages_id_with_data_.end()) {
+        ticks.assign(data_it->second.begin() + index_of_begin_tick, data_it->second.begin() + index_of_end_tick);
+        return true;
+    }
+
+    const PackageDataColumns &package_columns = packages_id_with_columns_.at(package_id);
+    ticks.resize(index_of_end_tick - index_of_begin_tick);
+    for (uint32_t i = index_of_begin_tick; i < index_of_end_tick; ++i) {
+        PackageDataPerTick &tick = ticks[i - index_of_begin_tick];
+        tick.timestamp_s = package_columns.timestamps_s[i];
+        tick.data.assign(package_columns.data_of_tick(i), package_columns.data_of_tick(i) + package_columns.size_of_data);
+        tick.index_in_file = package_columns.indices_in_file[i];
+        tick.size_of_all_in_file = package_columns.size_of_all_in_file;
+    }
+    return true;
+}
+
+bool BinaryDataLog::QueryNearestTicks(const std::vector<uint16_t> &package_ids, const float time_stamp_s, std::vector<uint32_t> &indices_of_ticks) const {
+    indices_of_ticks.resize(package_ids.size());
+    for (uint32_t i = 0; i < package_ids.size(); ++i) {
+        const auto data_it = packages_id_with_data_.find(package_ids[i]);
+        if (data_it != packages_id_with_data_.end() && !data_it->second.empty()) {
+            indices_of_ticks[i] = QueryNearestTickInSortedVector(data_it->second, time_stamp_s);
+            continue;
+        }
+        const auto columns_it = packages_id_with_columns_.find(package_ids[i]);
+        if (columns_it != packages_id_with_columns_.end() && columns_it->second.size() > 0) {
+            indices_of_ticks[i] = QueryNearestTickInSortedVector(columns_it->second.timestamps_s, time_stamp_s);
+            continue;
+        }
+        ReportError("[DataLog] Package id " << package_ids[i] << " is not loaded.");
+        indices_of_ticks.clear();
+        return false;
+    }
+    return true;
+}
+
+void BinaryDataLog::SortLoadedPackagesByTimestamp() {
+    // Timestamps are usually recorded in order, so sorting is skipped in most cases.
+    for (auto &pair: packages_id_with_data_) {
+        auto &package_data = pair.second;
+        const auto compare = [](const PackageDataPerTick &tick_a, const PackageDataPerTick &tick_b) { return tick_a.timestamp_s < tick_b.timestamp_s; };
+        if (!std::is_sorted(package_data.begin(), package_data.end(), compare)) {
+            std::stable_sort(package_data.begin(), package_data.end(), compare);
+        }
+    }
+
+    for (auto &pair: packages_id_with_columns_) {
+        auto &package_columns = pair.second;
+        if (std::is_sorted(package_columns.timestamps_s.begin(), package_columns.timestamps_s.end())) {
+            continue;
+        }
+        std::vector<uint32_t> sorted_indices(package_columns.size());
+        std::iota(sorted_indices.begin(), sorted_indices.end(), 0);
+        std::stable_sort(sorted_indices.begin(), sorted_indices.end(),
+                         [&](const uint32_t a, const uint32_t b) { return package_columns.timestamps_s[a] < package_columns.timestamps_s[b]; });
+
+        PackageDataColumns sorted_columns;
+        sorted_columns.size_of_data = package_columns.size_of_data;
+        sorted_columns.size_of_all_in_file = package_columns.size_of_all_in_file;
+        sorted_columns.timestamps_s.reserve(sorted_indices.size());
+        sorted_columns.indices_in_file.reserve(sorted_indices.size());
+        sorted_columns.data.reserve(package_columns.data.size());
+        for (const uint32_t index: sorted_indices) {
+            sorted_columns.timestamps_s.emplace_back(package_columns.timestamps_s[index]);
+            sorted_columns.indices_in_file.emplace_back(package_columns.indices_in_file[index]);
+            sorted_columns.data.insert(sorted_columns.data.end(), package_columns.data_of_tick(index),
+                                       package_columns.data_of_tick(index) + package_columns.size_of_data);
+        }
+        package_columns = std::move(sorted_columns);
+    }
+}
+
+}  // namespace slam_data_log
@@ -0,0 +1,144 @@
+#include "binary_data_log.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "cstring"
+
+namespace slam_data_log {
+
+bool BinaryDataLog::EnableAsyncRecording(const uint32_t ring_buffer_size) {
+    if (file_w_ptr_ == nullptr) {
+        ReportError("[DataLog] Log file should be created before enabling asynchronous recording.");
+        return false;
+    }
+    if (ring_buffer_size == 0) {
+        ReportError("[DataLog] Ring buffer size of asynchronous recorder should not be zero.");
+        return false;
+    }
+
+    // If asynchronous recorder is running, drain it before resizing ring buffer.
+    StopAsyncRecording();
+
+    // Preallocate ring buffer, so recording will never allocate memory.
+    async_ring_buffer_.resize(ring_buffer_size);
+    async_ring_reserve_index_ = committed_size_in_file_;
+    async_ring_commit_index_ = committed_size_in_file_;
+    async_ring_read_index_ = committed_size_in_file_;
+    async_writer_stop_ = false;
+    async_writer_thread_ = std::thread(&BinaryDataLog::AsyncWriterLoop, this);
+
+    return true;
+}
+
+bool BinaryDataLog::FlushAsyncRecording() {
+    RETURN_FALSE_IF(file_w_ptr_ == nullptr);
+
+    if (IsAsyncRecording()) {
+        // Wait until writer thread has drained all bytes reserved before now.
+        const uint64_t reserve_index = async_ring_reserve_index_.load(std::memory_order_acquire);
+        uint64_t read_index = async_ring_read_index_.load(std::memory_order_acquire);
+        while (read_index < reserve_index) {
+            async_ring_read_index_.wait(read_index, std::memory_order_acquire);
+            read_index = async_ring_read_index_.load(std::memory_order_acquire);
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(file_w_mutex_);
+    file_w_ptr_->flush();
+    return file_w_ptr_->good();
+}
+
+void BinaryDataLog::StopAsyncRecording() {
+    RETURN_IF(!IsAsyncRecording());
+
+    // Writer thread will drain all published bytes in ring buffer before exiting.
+    async_writer_stop_.store(true, std::memory_order_release);
+    async_writer_signal_.fetch_add(1, std::memory_order_release);
+    async_writer_signal_.notify_all();
+    async_writer_thread_.join();
+    committed_size_in_file_ = async_ring_reserve_index_.load(std::memory_order_acquire);
+
+    if (file_w_ptr_ != nullptr) {
+        file_w_ptr_->flush();
+    }
+    async_ring_buffer_.clear();
+    async_ring_buffer_.shrink_to_fit();
+}
+
+void BinaryDataLog::CommitBytesToAsyncRingBuffer(const char *data_ptr, const uint64_t size, const bool record_in_index) {
+    RETURN_IF(size == 0);
+
+    // Reserve a range in ring buffer without lock. Recorders in other threads will reserve after it.
+    const uint64_t ring_buffer_size = async_ring_buffer_.size();
+    const uint64_t begin_index = async_ring_reserve_index_.fetch_add(size, std::memory_order_acq_rel);
+    const uint64_t end_index = begin_index + size;
+
+    uint64_t copied_index = begin_index;
+    uint64_t published_index = begin_index;
+    bool is_recorded_in_index = !record_in_index;
+    while (published_index < end_index) {
+        // Copy bytes into free space of ring buffer. Writer thread never touches this part.
+        const uint64_t read_index = async_ring_read_index_.load(std::memory_order_acquire);
+        while (copied_index < end_index && copied_index < read_index + ring_buffer_size) {
+            const uint64_t position = copied_index % ring_buffer_size;
+            const uint64_t copy_size = std::min({end_index - copied_index, read_index + ring_buffer_size - copied_index, ring_buffer_size - position});
+            std::memcpy(async_ring_buffer_.data() + position, data_ptr + (copied_index - begin_index), copy_size);
+            copied_index += copy_size;
+        }
+
+        // Bytes can only be published after all bytes reserved before them are published.
+        const uint64_t commit_index = async_ring_commit_index_.load(std::memory_order_acquire);
+        if (commit_index != published_index) {
+            async_ring_commit_index_.wait(commit_index, std::memory_order_acquire);
+            continue;
+        }
+
+        // It is the turn of this recorder now, so frames are recorded in index in the same order as in file.
+        if (!is_recorded_in_index) {
+            RecordFrameInIndex(begin_index, data_ptr, static_cast<uint32_t>(size));
+            is_recorded_in_index = true;
+        }
+
+        // If ring buffer is full of published bytes, wait for writer thread. This only happens when frame is larger than ring buffer.
+        if (copied_index == published_index) {
+            async_ring_read_index_.wait(read_index, std::memory_order_acquire);
+            continue;
+        }
+
+        // Publish copied bytes to writer thread and the next recorder.
+        published_index = copied_index;
+        async_ring_commit_index_.store(published_index, std::memory_order_release);
+        async_ring_commit_index_.notify_all();
+        async_writer_signal_.fetch_add(1, std::memory_order_release);
+        async_writer_signal_.notify_one();
+    }
+}
+
+void BinaryDataLog::AsyncWriterLoop() {
+    const uint64_t ring_buffer_size = async_ring_buffer_.size();
+    while (true) {
+        // Load signal before commit index, so publishing after this check will not be missed.
+        const uint32_t signal = async_writer_signal_.load(std::memory_order_acquire);
+        const uint64_t read_index = async_ring_read_index_.load(std::memory_order_relaxed);
+        const uint64_t commit_index = async_ring_commit_index_.load(std::memory_order_acquire);
+        if (commit_index == read_index) {
+            BREAK_IF(async_writer_stop_.load(std::memory_order_acquire));
+            async_writer_signal_.wait(signal, std::memory_order_acquire);
+            continue;
+        }
+
+        // Write the contiguous published bytes into log file.
+        const uint64_t position = read_index % ring_buffer_size;
+        const uint64_t write_size = std::min(commit_index - read_index, ring_buffer_size - position);
+        {
+            std::unique_lock<std::mutex> lock(file_w_mutex_);
+            file_w_ptr_->write(async_ring_buffer_.data() + position, write_size);
+        }
+
+        // Release these bytes to recorders.
+        async_ring_read_index_.store(read_index + write_size, std::memory_order_release);
+        async_ring_read_index_.notify_all();
+    }
+}
+
+}  // namespace slam_data_log
@@ -3,9 +3,14 @@
 #include "slam_operations.h"
 
 #include "chrono"
+#include "cstring"
 
 namespace slam_data_log {
 
+// Point cloud and line cloud are directly copied from memory of Vec3.
+static_assert(sizeof(Vec3) == 3 * sizeof(float), "Vec3 should be packed by three floats.");
+static_assert(sizeof(std::pair<Vec3, Vec3>) == 2 * sizeof(Vec3), "Line should be packed by two Vec3.");
+
 bool BinaryDataLog::RecordPackage(const uint16_t package_id, const GrayImage &image, const float time_stamp_s) {
     return RecordImage(package_id, 1, image.rows(), image.cols(), image.data(), time_stamp_s);
 }
@@ -38,38 +43,19 @@ bool BinaryDataLog::RecordImage(const uint16_t package_id, const int32_t channel
     // pixel_value, channel, rows, cols.
     const uint32_t image_data_size = pixel_value_size + 1 + 2 + 2;
 
-    // Write the offset to the next package data.
-    // offset, package_id, timestamp, binary_data, check_byte.
-    const uint32_t offset = 4 + 2 + 4 + image_data_size + 1;
-    file_w_ptr_->write(reinterpret_cast<const char *>(&offset), 4);
-    uint8_t sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&offset), 4, 0);
-    // Write the package id.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&it->first), 2);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&it->first), 2, sum_check_byte);
-    // Write the system timestamp.
-    const float timestamp = time_stamp_s;
-    file_w_ptr_->write(reinterpret_cast<const char *>(&timestamp), 4);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&timestamp), 4, sum_check_byte);
-
-    // Write the binary data.
-    // Write image channels.
-    uint8_t temp_channels = static_cast<uint8_t>(channels);
-    file_w_ptr_->write(reinterpret_cast<const char *>(&temp_channels), 1);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&temp_channels), 1, sum_check_byte);
-    // Write image rows/height.
-    uint16_t temp_rows = static_cast<uint16_t>(image_rows);
-    file_w_ptr_->write(reinterpret_cast<const char *>(&temp_rows), 2);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&temp_rows), 2, sum_check_byte);
-    // Write image cols/width.
-    uint16_t temp_cols = static_cast<uint16_t>(image_cols);
-    file_w_ptr_->write(reinterpret_cast<const char *>(&temp_cols), 2);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&temp_cols), 2, sum_check_byte);
+    // Build the whole frame in staging buffer, then write it at once.
+    char *binary_data_ptr = BeginFrameInStagingBuffer(it->first, time_stamp_s, image_data_size);
+    // Write image channels, rows/height and cols/width.
+    const uint8_t temp_channels = static_cast<uint8_t>(channels);
+    const uint16_t temp_rows = static_cast<uint16_t>(image_rows);
+    const uint16_t temp_cols = static_cast<uint16_t>(image_cols);
+    std::memcpy(binary_data_ptr, &temp_channels, 1);
+    std::memcpy(binary_data_ptr + 1, &temp_rows, 2);
+    std::memcpy(binary_data_ptr + 3, &temp_cols, 2);
     // Write image pixel value.
-    file_w_ptr_->write(reinterpret_cast<const char *>(data_ptr), pixel_value_size);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(data_ptr), pixel_value_size, sum_check_byte);
+    std::memcpy(binary_data_ptr + 5, data_ptr, pixel_value_size);
+    EndFrameInStagingBuffer();
 
-    // Write the summary check byte.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&sum_check_byte), 1);
     return true;
 }
 
@@ -90,35 +76,17 @@ bool BinaryDataLog::RecordPackage(const uint16_t package_id, const Mat &matrix,
     // Matrix elements, rows, cols.
     const uint32_t matrix_data_size = element_num + 2 + 2;
 
-    // Write the offset to the next package data.
-    // offset, package_id, timestamp, binary_data, check_byte.
-    const uint32_t offset = 4 + 2 + 4 + matrix_data_size + 1;
-    file_w_ptr_->write(reinterpret_cast<const char *>(&offset), 4);
-    uint8_t sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&offset), 4, 0);
-    // Write the package id.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&it->first), 2);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&it->first), 2, sum_check_byte);
-    // Write the system timestamp.
-    const float timestamp = time_stamp_s;
-    file_w_ptr_->write(reinterpret_cast<const char *>(&timestamp), 4);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&timestamp), 4, sum_check_byte);
-
-    // Write the binary data.
-    // Write matrix rows/height.
-    uint16_t temp_rows = static_cast<uint16_t>(matrix.rows());
-    file_w_ptr_->write(reinterpret_cast<const char *>(&temp_rows), 2);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&temp_rows), 2, sum_check_byte);
-    // Write matrix cols/width.
-    uint16_t temp_cols = static_cast<uint16_t>(matrix.cols());
-    file_w_ptr_->write(reinterpret_cast<const char *>(&temp_cols), 2);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&temp_cols), 2, sum_check_byte);
-    // Write matrix element value.
-    MatImgF row_major_matrix = matrix;
-    file_w_ptr_->write(reinterpret_cast<const char *>(row_major_matrix.data()), element_num);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(row_major_matrix.data()), element_num, sum_check_byte);
-
-    // Write the summary check byte.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&sum_check_byte), 1);
+    // Build the whole frame in staging buffer, then write it at once.
+    char *binary_data_ptr = BeginFrameInStagingBuffer(it->first, time_stamp_s, matrix_data_size);
+    // Write matrix rows/height and cols/width.
+    const uint16_t temp_rows = static_cast<uint16_t>(matrix.rows());
+    const uint16_t temp_cols = static_cast<uint16_t>(matrix.cols());
+    std::memcpy(binary_data_ptr, &temp_rows, 2);
+    std::memcpy(binary_data_ptr + 2, &temp_cols, 2);
+    // Write matrix element value in row major, directly into staging buffer.
+    Eigen::Map<MatImgF>(reinterpret_cast<float *>(binary_data_ptr + 4), matrix.rows(), matrix.cols()) = matrix;
+    EndFrameInStagingBuffer();
+
     return true;
 }
 
@@ -142,29 +110,13 @@ bool BinaryDataLog::RecordPackage(const uint16_t package_id, const std::vector<u
     const uint32_t num_of_bytes = static_cast<uint32_t>(data_bytes.size());
     const uint32_t png_image_data_size = 4 + num_of_bytes;
 
-    // Write the offset to the next package data.
-    // offset, package_id, timestamp, binary_data, check_byte.
-    const uint32_t offset = 4 + 2 + 4 + png_image_data_size + 1;
-    file_w_ptr_->write(reinterpret_cast<const char *>(&offset), 4);
-    uint8_t sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&offset), 4, 0);
-    // Write the package id.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&it->first), 2);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&it->first), 2, sum_check_byte);
-    // Write the system timestamp.
-    const float timestamp = time_stamp_s;
-    file_w_ptr_->write(reinterpret_cast<const char *>(&timestamp), 4);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&timestamp), 4, sum_check_byte);
-
-    // Write the binary data.
-    // Write the number of date bytes.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&num_of_bytes), 4);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&num_of_bytes), 4, sum_check_byte);
-    // Directly write all data bytes.
-    file_w_ptr_->write(reinterpret_cast<const char *>(data_bytes.data()), num_of_bytes);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(data_bytes.data()), num_of_bytes, sum_check_byte);
-
-    // Write the summary check byte.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&sum_check_byte), 1);
+    // Build the whole frame in staging buffer, then write it at once.
+    char *binary_data_ptr = BeginFrameInStagingBuffer(it->first, time_stamp_s, png_image_data_size);
+    // Write the number of date bytes, then directly write all data bytes.
+    std::memcpy(binary_data_ptr, &num_of_bytes, 4);
+    std::memcpy(binary_data_ptr + 4, data_bytes.data(), num_of_bytes);
+    EndFrameInStagingBuffer();
+
     return true;
 }
 
@@ -175,7 +127,7 @@ bool BinaryDataLog::RecordPackage(const uint16_t package_id, const std::vector<V
 }
 
 bool BinaryDataLog::RecordPackage(const uint16_t package_id, const std::vector<Vec3> &points_cloud, const int32_t step) {
-    return RecordPackage(package_id, points_cloud, GetSystemTimestamp(), step);
+    return RecordPackage(package_id, points_cloud, step, GetSystemTimestamp());
 }
 
 bool BinaryDataLog::RecordPackage(const uint16_t package_id, const std::vector<Vec3> &points_cloud, const int32_t step, const float time_stamp_s) {
@@ -191,37 +143,21 @@ bool BinaryDataLog::RecordPackage(const uint16_t package_id, const std::vector<V
     const uint32_t num_of_points = static_cast<uint32_t>(points_cloud.size()) / step;
     const uint32_t point_cloud_data_size = 4 + num_of_points * 3 * sizeof(float);
 
-    // Write the offset to the next package data.
-    // offset, package_id, timestamp, binary_data, check_byte.
-    const uint32_t offset = 4 + 2 + 4 + point_cloud_data_size + 1;
-    file_w_ptr_->write(reinterpret_cast<const char *>(&offset), 4);
-    uint8_t sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&offset), 4, 0);
-    // Write the package id.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&it->first), 2);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&it->first), 2, sum_check_byte);
-    // Write the system timestamp.
-    const float timestamp = time_stamp_s;
-    file_w_ptr_->write(reinterpret_cast<const char *>(&timestamp), 4);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&timestamp), 4, sum_check_byte);
-
-    // Write the binary data.
-    // Write the number of date bytes.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&num_of_points), 4);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&num_of_points), 4, sum_check_byte);
-    // Iterate points cloud, directly write all data bytes.
-    uint32_t cnt = 0;
-    for (uint32_t id = 0; id < points_cloud.size(); id += step) {
-        const auto &point = points_cloud[id];
-        for (uint32_t i = 0; i < 3; ++i) {
-            file_w_ptr_->write(reinterpret_cast<const char *>(&point[i]), 4);
-            sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&point[i]), 4, sum_check_byte);
+    // Build the whole frame in staging buffer, then write it at once.
+    char *binary_data_ptr = BeginFrameInStagingBuffer(it->first, time_stamp_s, point_cloud_data_size);
+    // Write the number of points.
+    std::memcpy(binary_data_ptr, &num_of_points, 4);
+    // Points are packed as [x, y, z] floats, which is the same as memory of Vec3.
+    char *points_ptr = binary_data_ptr + 4;
+    if (step == 1) {
+        std::memcpy(points_ptr, points_cloud.data(), num_of_points * sizeof(Vec3));
+    } else {
+        for (uint32_t i = 0; i < num_of_points; ++i) {
+            std::memcpy(points_ptr + i * sizeof(Vec3), points_cloud[i * step].data(), sizeof(Vec3));
         }
-        ++cnt;
-        BREAK_IF(cnt >= num_of_points);
     }
+    EndFrameInStagingBuffer();
 
-    // Write the summary check byte.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&sum_check_byte), 1);
     return true;
 }
 
@@ -241,38 +177,15 @@ bool BinaryDataLog::RecordPackage(const uint16_t package_id, const std::vector<s
     const uint32_t num_of_lines = static_cast<uint32_t>(line_cloud.size());
     const uint32_t line_cloud_data_size = 4 + num_of_lines * 2 * 3 * sizeof(float);
 
-    // Write the offset to the next package data.
-    const uint32_t offset = 4 + 2 + 4 + line_cloud_data_size + 1;
-    file_w_ptr_->write(reinterpret_cast<const char *>(&offset), 4);
-    uint8_t sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&offset), 4, 0);
-    // Write the package id.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&it->first), 2);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&it->first), 2, sum_check_byte);
-    // Write the system timestamp.
-    const float timestamp = time_stamp_s;
-    file_w_ptr_->write(reinterpret_cast<const char *>(&timestamp), 4);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&timestamp), 4, sum_check_byte);
-
-    // Write the binary data.
+
+    // Build the whole frame in staging buffer, then write it at once.
+    char *binary_data_ptr = BeginFrameInStagingBuffer(it->first, time_stamp_s, line_cloud_data_size);
     // Write the number of lines.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&num_of_lines), 4);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&num_of_lines), 4, sum_check_byte);
-    // Iterate lines cloud, directly write all data bytes.
-    for (const auto &line : line_cloud) {
-        // Point 1
-        for (uint32_t i = 0; i < 3; ++i) {
-            file_w_ptr_->write(reinterpret_cast<const char *>(&line.first[i]), 4);
-            sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&line.first[i]), 4, sum_check_byte);
-        }
-        // Point 2
-        for (uint32_t i = 0; i < 3; ++i) {
-            file_w_ptr_->write(reinterpret_cast<const char *>(&line.second[i]), 4);
-            sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&line.second[i]), 4, sum_check_byte);
-        }
-    }
+    std::memcpy(binary_data_ptr, &num_of_lines, 4);
+    // Lines are packed as [x1, y1, z1, x2, y2, z2] floats, which is the same as memory of std::pair<Vec3, Vec3>.
+    std::memcpy(binary_data_ptr + 4, line_cloud.data(), num_of_lines * sizeof(std::pair<Vec3, Vec3>));
+    EndFrameInStagingBuffer();
 
-    // Write the summary check byte.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&sum_check_byte), 1);
     return true;
 }
 
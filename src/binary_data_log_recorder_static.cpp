@@ -3,6 +3,7 @@
 #include "slam_operations.h"
 
 #include "chrono"
+#include "cstring"
 
 namespace slam_data_log {
 
@@ -36,7 +37,7 @@ bool BinaryDataLog::RecordAllRegisteredPackagesAsFileHead() {
     }
 
     // Write the offset index to the beginning of Part 3.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&offsets.front()), 4);
+    WriteBytesToLogFile(reinterpret_cast<const char *>(&offsets.front()), 4);
 
     // Iterate each package.
     uint32_t index = 1;
@@ -44,37 +45,38 @@ bool BinaryDataLog::RecordAllRegisteredPackagesAsFileHead() {
         auto &package = pair.second;
 
         // Write the offset index to the next package name.
-        file_w_ptr_->write(reinterpret_cast<const char *>(&offsets[index]), 4);
+        WriteBytesToLogFile(reinterpret_cast<const char *>(&offsets[index]), 4);
         uint8_t sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&offsets[index]), 4, 0);
         ++index;
         // Write the package id.
-        file_w_ptr_->write(reinterpret_cast<const char *>(&package->id), 2);
+        WriteBytesToLogFile(reinterpret_cast<const char *>(&package->id), 2);
         sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&package->id), 2, sum_check_byte);
         // Write the size of package name.
         const uint8_t name_size = static_cast<uint8_t>(package->name.size());
-        file_w_ptr_->write(reinterpret_cast<const char *>(&name_size), 1);
+        WriteBytesToLogFile(reinterpret_cast<const char *>(&name_size), 1);
         sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&name_size), 1, sum_check_byte);
         // Write the package name.
-        file_w_ptr_->write(package->name.c_str(), package->name.size());
+        WriteBytesToLogFile(package->name.c_str(), package->name.size());
         sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(package->name.c_str()), package->name.size(), sum_check_byte);
 
         // Iterate each item of this package.
         for (auto &item: package->items) {
             // Write the type of item.
-            file_w_ptr_->write(reinterpret_cast<const char *>(&item.type), 1);
+            WriteBytesToLogFile(reinterpret_cast<const char *>(&item.type), 1);
             sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&item.type), 1, sum_check_byte);
             // Write the size of item name.
             const uint8_t name_size = static_cast<uint8_t>(item.name.size());
-            file_w_ptr_->write(reinterpret_cast<const char *>(&name_size), 1);
+            WriteBytesToLogFile(reinterpret_cast<const char *>(&name_size), 1);
             sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&name_size), 1, sum_check_byte);
             // Write the item name.
-            file_w_ptr_->write(item.name.c_str(), item.name.size());
+            WriteBytesToLogFile(item.name.c_str(), item.name.size());
             sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(item.name.c_str()), item.name.size(), sum_check_byte);
         }
 
         // Write the summary check byte.
-        file_w_ptr_->write(reinterpret_cast<const char *>(&sum_check_byte), 1);
+        WriteBytesToLogFile(reinterpret_cast<const char *>(&sum_check_byte), 1);
     }
+    CommitStagedBytesToLogFile();
 
     return true;
 }
@@ -97,27 +99,10 @@ bool BinaryDataLog::RecordPackage(const uint16_t package_id, const char *data_pt
         return false;
     }
 
-    // Write the offset to the next package data.
-    // offset, package_id, timestamp, binary_data, check_byte.
-    const uint32_t offset = 4 + 2 + 4 + it->second->size + 1;
-    file_w_ptr_->write(reinterpret_cast<const char *>(&offset), 4);
-    uint8_t sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&offset), 4, 0);
-
-    // Write the package id.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&it->first), 2);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&it->first), 2, sum_check_byte);
-
-    // Write the system timestamp.
-    const float timestamp = time_stamp_s;
-    file_w_ptr_->write(reinterpret_cast<const char *>(&timestamp), 4);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(&timestamp), 4, sum_check_byte);
-
-    // Write the binary data.
-    file_w_ptr_->write(data_ptr, it->second->size);
-    sum_check_byte = SummaryBytes(reinterpret_cast<const uint8_t *>(data_ptr), it->second->size, sum_check_byte);
-
-    // Write the summary check byte.
-    file_w_ptr_->write(reinterpret_cast<const char *>(&sum_check_byte), 1);
+    // Build the whole frame in staging buffer, then write it at once.
+    char *binary_data_ptr = BeginFrameInStagingBuffer(it->first, time_stamp_s, it->second->size);
+    std::memcpy(binary_data_ptr, data_ptr, it->second->size);
+    EndFrameInStagingBuffer();
 
     return true;
 }
@@ -0,0 +1,273 @@
+#include "binary_data_log_replayer.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "algorithm"
+#include "queue"
+
+namespace slam_data_log {
+
+BinaryDataLogReplayer::~BinaryDataLogReplayer() { Stop(); }
+
+void BinaryDataLogReplayer::SetCallback(const uint16_t package_id, const Callback &callback) { packages_id_with_callback_[package_id] = callback; }
+
+bool BinaryDataLogReplayer::Start(const float timestamp_s) {
+    Stop();
+    MergeScheduleOfPackages();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_paused_ = false;
+        statistics_ = Statistics();
+    }
+    return StartThreads(timestamp_s);
+}
+
+void BinaryDataLogReplayer::Stop() { StopThreads(); }
+
+void BinaryDataLogReplayer::Pause() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_paused_ = true;
+    state_signal_.notify_all();
+}
+
+void BinaryDataLogReplayer::Resume() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_paused_ = false;
+    state_signal_.notify_all();
+}
+
+bool BinaryDataLogReplayer::Seek(const float timestamp_s) {
+    // Ticks decoded before seeking are useless, so replay again from the new timestamp. Pause state is kept.
+    StopThreads();
+    return StartThreads(timestamp_s);
+}
+
+void BinaryDataLogReplayer::WaitUntilFinished() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    state_signal_.wait(lock, [this]() { return is_finished_; });
+}
+
+bool BinaryDataLogReplayer::IsReplaying() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !is_finished_;
+}
+
+BinaryDataLogReplayer::Statistics BinaryDataLogReplayer::statistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+float BinaryDataLogReplayer::current_timestamp_s() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_timestamp_s_;
+}
+
+bool BinaryDataLogReplayer::is_paused() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return is_paused_;
+}
+
+void BinaryDataLogReplayer::MergeScheduleOfPackages() {
+    // Ticks of each package are sorted by timestamp, so they are merged by a heap of the next tick of each package.
+    // Ticks with the same timestamp are replayed in file order.
+    struct PackageCursor {
+        uint16_t package_id = 0;
+        const float *timestamps_s = nullptr;
+        const PackageDataPerTick *ticks = nullptr;
+        const uint64_t *indices_in_file = nullptr;
+        uint32_t index_of_tick = 0;
+        uint32_t num_of_ticks = 0;
+
+        float timestamp_s() const { return ticks != nullptr ? ticks[index_of_tick].timestamp_s : timestamps_s[index_of_tick]; }
+        uint64_t index_in_file() const { return ticks != nullptr ? ticks[index_of_tick].index_in_file : indices_in_file[index_of_tick]; }
+    };
+    const auto is_later = [](const PackageCursor &cursor_a, const PackageCursor &cursor_b) {
+        const float timestamp_s_a = cursor_a.timestamp_s();
+        const float timestamp_s_b = cursor_b.timestamp_s();
+        return timestamp_s_a != timestamp_s_b ? timestamp_s_a > timestamp_s_b : cursor_a.index_in_file() > cursor_b.index_in_file();
+    };
+    std::priority_queue<PackageCursor, std::vector<PackageCursor>, decltype(is_later)> cursors(is_later);
+
+    uint64_t num_of_ticks = 0;
+    for (const auto &pair: packages_id_with_callback_) {
+        PackageCursor cursor;
+        cursor.package_id = pair.first;
+        const auto data_it = log_.packages_id_with_data().find(pair.first);
+        const auto columns_it = log_.packages_id_with_columns().find(pair.first);
+        if (data_it != log_.packages_id_with_data().end()) {
+            cursor.ticks = data_it->second.data();
+            cursor.num_of_ticks = static_cast<uint32_t>(data_it->second.size());
+        } else if (columns_it != log_.packages_id_with_columns().end()) {
+            cursor.timestamps_s = columns_it->second.timestamps_s.data();
+            cursor.indices_in_file = columns_it->second.indices_in_file.data();
+            cursor.num_of_ticks = columns_it->second.size();
+        } else {
+            ReportWarn("[DataLog] Package id " << pair.first << " to replay is not loaded.");
+        }
+        if (cursor.num_of_ticks > 0) {
+            cursors.push(cursor);
+            num_of_ticks += cursor.num_of_ticks;
+        }
+    }
+
+    schedule_.clear();
+    schedule_.reserve(num_of_ticks);
+    while (!cursors.empty()) {
+        PackageCursor cursor = cursors.top();
+        cursors.pop();
+        schedule_.emplace_back(ScheduledTick {.timestamp_s = cursor.timestamp_s(), .package_id = cursor.package_id, .index_of_tick = cursor.index_of_tick});
+        ++cursor.index_of_tick;
+        if (cursor.index_of_tick < cursor.num_of_ticks) {
+            cursors.push(cursor);
+        }
+    }
+}
+
+bool BinaryDataLogReplayer::StartThreads(const float timestamp_s) {
+    if (schedule_.empty()) {
+        ReportError("[DataLog] No package is loaded to replay.");
+        return false;
+    }
+
+    const auto it = std::lower_bound(schedule_.begin(), schedule_.end(), timestamp_s,
+                                     [](const ScheduledTick &scheduled_tick, const float timestamp_s) { return scheduled_tick.timestamp_s < timestamp_s; });
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        decoded_queue_.clear();
+        is_decoder_finished_ = false;
+        is_finished_ = false;
+        stop_ = false;
+        is_anchored_ = false;
+        current_timestamp_s_ = std::max(timestamp_s, schedule_.front().timestamp_s);
+    }
+    const uint32_t size_of_decoded_queue = std::max<uint32_t>(1, size_of_decoded_queue_);
+    decoder_thread_ = std::thread(&BinaryDataLogReplayer::DecoderLoop, this, static_cast<uint64_t>(it - schedule_.begin()), size_of_decoded_queue);
+    dispatcher_thread_ = std::thread(&BinaryDataLogReplayer::DispatcherLoop, this, speed_, as_fast_as_possible_ || speed_ <= 0.0f, size_of_decoded_queue);
+    return true;
+}
+
+void BinaryDataLogReplayer::StopThreads() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    queue_signal_.notify_all();
+    state_signal_.notify_all();
+    if (decoder_thread_.joinable()) {
+        decoder_thread_.join();
+    }
+    if (dispatcher_thread_.joinable()) {
+        dispatcher_thread_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    decoded_queue_.clear();
+    is_finished_ = true;
+    state_signal_.notify_all();
+}
+
+bool BinaryDataLogReplayer::DecodeScheduledTick(const ScheduledTick &scheduled_tick, DecodedTick &decoded_tick) const {
+    PackageDataView &package_data_view = decoded_tick.package_data_view;
+    package_data_view.package_id = scheduled_tick.package_id;
+    package_data_view.timestamp_s = scheduled_tick.timestamp_s;
+
+    const auto data_it = log_.packages_id_with_data().find(scheduled_tick.package_id);
+    if (data_it == log_.packages_id_with_data().end()) {
+        const PackageDataColumns &package_columns = log_.packages_id_with_columns().at(scheduled_tick.package_id);
+        package_data_view.data = package_columns.data_of_tick(scheduled_tick.index_of_tick);
+        package_data_view.size_of_data = package_columns.size_of_data;
+        package_data_view.index_in_file = package_columns.indices_in_file[scheduled_tick.index_of_tick];
+        package_data_view.size_of_all_in_file = package_columns.size_of_all_in_file;
+        return true;
+    }
+
+    const PackageDataPerTick &tick = data_it->second[scheduled_tick.index_of_tick];
+    package_data_view.index_in_file = tick.index_in_file;
+    package_data_view.size_of_all_in_file = tick.size_of_all_in_file;
+    if (!tick.data.empty()) {
+        package_data_view.data = tick.data.data();
+        package_data_view.size_of_data = static_cast<uint32_t>(tick.data.size());
+        return true;
+    }
+
+    // Data of package with dynamic size is not loaded, so load it from log file.
+    const uint32_t check_size = log_.frame_check_type() == FrameCheckType::kCrc32c ? 4 : 1;
+    RETURN_FALSE_IF(tick.size_of_all_in_file < 4 + 2 + 4 + check_size);
+    decoded_tick.payload = log_.LoadBinaryDataViewFromLogFile(tick.index_in_file, tick.size_of_all_in_file);
+    RETURN_FALSE_IF(decoded_tick.payload.empty());
+    package_data_view.data = decoded_tick.payload.data() + 4 + 2 + 4;
+    package_data_view.size_of_data = tick.size_of_all_in_file - 4 - 2 - 4 - check_size;
+    return true;
+}
+
+void BinaryDataLogReplayer::DecoderLoop(const uint64_t index_of_first_scheduled_tick, const uint32_t size_of_decoded_queue) {
+    for (uint64_t i = index_of_first_scheduled_tick; i < schedule_.size(); ++i) {
+        DecodedTick decoded_tick;
+        if (!DecodeScheduledTick(schedule_[i], decoded_tick)) {
+            ReportWarn("[DataLog] Replay package id " << schedule_[i].package_id << " at " << schedule_[i].timestamp_s << "s failed, skip it.");
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        queue_signal_.wait(lock, [&]() { return stop_ || decoded_queue_.size() < size_of_decoded_queue; });
+        RETURN_IF(stop_);
+        decoded_queue_.emplace_back(std::move(decoded_tick));
+        queue_signal_.notify_all();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_decoder_finished_ = true;
+    queue_signal_.notify_all();
+}
+
+void BinaryDataLogReplayer::DispatcherLoop(const float speed, const bool as_fast_as_possible, const uint32_t size_of_decoded_queue) {
+    while (true) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        queue_signal_.wait(lock, [this]() { return stop_ || !decoded_queue_.empty() || is_decoder_finished_; });
+        RETURN_IF(stop_);
+        if (decoded_queue_.empty()) {
+            is_finished_ = true;
+            state_signal_.notify_all();
+            return;
+        }
+
+        // Wait until scheduled time of this tick. Pausing or stopping breaks waiting, and schedule is anchored again after resuming.
+        const float timestamp_s = decoded_queue_.front().package_data_view.timestamp_s;
+        std::chrono::steady_clock::time_point scheduled_time = std::chrono::steady_clock::now();
+        while (!stop_) {
+            if (is_paused_) {
+                is_anchored_ = false;
+                state_signal_.wait(lock, [this]() { return stop_ || !is_paused_; });
+                continue;
+            }
+            BREAK_IF(as_fast_as_possible);
+            if (!is_anchored_) {
+                // Fill decoded queue before anchoring, so the first ticks will not be delayed by decoding.
+                queue_signal_.wait(lock, [&]() { return stop_ || is_paused_ || is_decoder_finished_ || decoded_queue_.size() >= size_of_decoded_queue; });
+                CONTINUE_IF(stop_ || is_paused_);
+                is_anchored_ = true;
+                anchor_timestamp_s_ = timestamp_s;
+                anchor_system_time_ = std::chrono::steady_clock::now();
+            }
+            scheduled_time = anchor_system_time_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                       std::chrono::duration<double>((timestamp_s - anchor_timestamp_s_) / speed));
+            BREAK_IF(!state_signal_.wait_until(lock, scheduled_time, [this]() { return stop_ || is_paused_; }));
+        }
+        RETURN_IF(stop_);
+
+        DecodedTick decoded_tick = std::move(decoded_queue_.front());
+        decoded_queue_.pop_front();
+        queue_signal_.notify_all();
+        const double delay_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - scheduled_time).count();
+        ++statistics_.num_of_dispatched_ticks;
+        statistics_.average_delay_us += (delay_us - statistics_.average_delay_us) / static_cast<double>(statistics_.num_of_dispatched_ticks);
+        statistics_.max_delay_us = std::max(statistics_.max_delay_us, delay_us);
+        current_timestamp_s_ = timestamp_s;
+        lock.unlock();
+
+        // Callbacks are not changed while replaying.
+        packages_id_with_callback_.at(decoded_tick.package_data_view.package_id)(decoded_tick.package_data_view);
+    }
+}
+
+}  // namespace slam_data_log
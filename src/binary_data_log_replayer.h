@@ -0,0 +1,137 @@
+#ifndef _BINARY_DATA_LOG_REPLAYER_H_
+#define _BINARY_DATA_LOG_REPLAYER_H_
+
+#include "binary_data_log.h"
+
+#include "chrono"
+#include "condition_variable"
+#include "cstring"
+#include "deque"
+#include "functional"
+#include "mutex"
+#include "thread"
+#include "unordered_map"
+#include "vector"
+
+namespace slam_data_log {
+
+/* Class BinaryDataLogReplayer Declaration. */
+// Replay loaded packages of log file in timestamp order, and call callbacks on the recorded schedule. Packages with dynamic size are
+// loaded in background before dispatching. Log file should not be loaded again while replaying.
+class BinaryDataLogReplayer {
+
+public:
+    static constexpr uint32_t kDefaultSizeOfDecodedQueue = 64;
+
+    // Binary data in view is only valid in callback.
+    using Callback = std::function<void(const PackageDataView &)>;
+
+    // Statistics are reset when starting, and accumulated after seeking.
+    struct Statistics {
+        uint64_t num_of_dispatched_ticks = 0;
+        // Delay of dispatching is the time after the recorded schedule.
+        double average_delay_us = 0.0;
+        double max_delay_us = 0.0;
+    };
+
+public:
+    explicit BinaryDataLogReplayer(const BinaryDataLog &log) : log_(log) {}
+    virtual ~BinaryDataLogReplayer();
+    BinaryDataLogReplayer(const BinaryDataLogReplayer &) = delete;
+    BinaryDataLogReplayer &operator=(const BinaryDataLogReplayer &) = delete;
+
+    // Only packages with callbacks are replayed. Callbacks should be set before starting.
+    void SetCallback(const uint16_t package_id, const Callback &callback);
+    template <typename T>
+    void SetCallback(const uint16_t package_id, const std::function<void(const float, const T &)> &callback);
+
+    // Control replaying. These methods should not be called in callbacks.
+    bool Start(const float timestamp_s = -INFINITY);
+    void Stop();
+    void Pause();
+    void Resume();
+    bool Seek(const float timestamp_s);
+    void WaitUntilFinished();
+    bool IsReplaying() const;
+
+    // Reference for member variables.
+    float &speed() { return speed_; }
+    bool &as_fast_as_possible() { return as_fast_as_possible_; }
+    uint32_t &size_of_decoded_queue() { return size_of_decoded_queue_; }
+
+    // Const Reference for member variables.
+    const float &speed() const { return speed_; }
+    const bool &as_fast_as_possible() const { return as_fast_as_possible_; }
+    const uint32_t &size_of_decoded_queue() const { return size_of_decoded_queue_; }
+    Statistics statistics() const;
+    float current_timestamp_s() const;
+    bool is_paused() const;
+
+private:
+    // One tick of one package in merged schedule.
+    struct ScheduledTick {
+        float timestamp_s = 0.0f;
+        uint16_t package_id = 0;
+        uint32_t index_of_tick = 0;
+    };
+
+    struct DecodedTick {
+        PackageDataView package_data_view;
+        // Keep binary data of package with dynamic size alive until dispatched.
+        BinaryDataView payload;
+    };
+
+private:
+    void MergeScheduleOfPackages();
+    bool StartThreads(const float timestamp_s);
+    void StopThreads();
+    bool DecodeScheduledTick(const ScheduledTick &scheduled_tick, DecodedTick &decoded_tick) const;
+    void DecoderLoop(const uint64_t index_of_first_scheduled_tick, const uint32_t size_of_decoded_queue);
+    void DispatcherLoop(const float speed, const bool as_fast_as_possible, const uint32_t size_of_decoded_queue);
+
+private:
+    const BinaryDataLog &log_;
+    std::unordered_map<uint16_t, Callback> packages_id_with_callback_;
+    std::vector<ScheduledTick> schedule_;
+
+    // Options, which are applied when starting or seeking.
+    float speed_ = 1.0f;
+    bool as_fast_as_possible_ = false;
+    uint32_t size_of_decoded_queue_ = kDefaultSizeOfDecodedQueue;
+
+    // Decoder thread pushes ticks into queue, and dispatcher thread pops them on schedule.
+    std::thread decoder_thread_;
+    std::thread dispatcher_thread_;
+    mutable std::mutex mutex_;
+    std::condition_variable queue_signal_;
+    std::condition_variable state_signal_;
+    std::deque<DecodedTick> decoded_queue_;
+    bool is_decoder_finished_ = false;
+    bool is_finished_ = true;
+    bool stop_ = false;
+    bool is_paused_ = false;
+    float current_timestamp_s_ = 0.0f;
+    // Scheduled time of a tick is anchor_system_time_ + (timestamp_s - anchor_timestamp_s_) / speed_.
+    bool is_anchored_ = false;
+    float anchor_timestamp_s_ = 0.0f;
+    std::chrono::steady_clock::time_point anchor_system_time_;
+    Statistics statistics_;
+};
+
+/* Class BinaryDataLogReplayer Definition. */
+template <typename T>
+void BinaryDataLogReplayer::SetCallback(const uint16_t package_id, const std::function<void(const float, const T &)> &callback) {
+    SetCallback(package_id, [callback](const PackageDataView &package_data_view) {
+        if (package_data_view.size_of_data != sizeof(T)) {
+            return;
+        }
+        // Binary data in log file is not aligned.
+        T data;
+        std::memcpy(&data, package_data_view.data, sizeof(T));
+        callback(package_data_view.timestamp_s, data);
+    });
+}
+
+}  // namespace slam_data_log
+
+#endif  // end of _BINARY_DATA_LOG_REPLAYER_H_
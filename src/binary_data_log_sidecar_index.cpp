@@ -0,0 +1,190 @@
+#include "binary_data_log.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "cstdio"
+#include "cstring"
+
+namespace slam_data_log {
+
+namespace {
+    // Size of log file, modified time of log file and hash of registered packages in log file.
+    constexpr uint32_t kSidecarIndexKeySize = 8 + 8 + 4;
+    // Package id and number of package contents.
+    constexpr uint32_t kSidecarIndexPackageSize = 2 + 4;
+    // Timestamp, index in file and size of all in file.
+    constexpr uint32_t kSidecarIndexTickSize = 4 + 8 + 4;
+}  // namespace
+
+std::string BinaryDataLog::SidecarIndexFileName() const { return mapped_file_r_.file_name() + ".idx"; }
+
+bool BinaryDataLog::SaveSidecarIndex() const {
+    // Index of all packages is needed, otherwise it cannot be used by loading other packages.
+    RETURN_FALSE_IF(!is_package_id_selected_.empty() || !mapped_file_r_.IsOpen());
+
+    std::vector<uint8_t> bytes;
+    const auto write_bytes = [&bytes](const void *data, const uint32_t size) {
+        const uint8_t *data_ptr = static_cast<const uint8_t *>(data);
+        bytes.insert(bytes.end(), data_ptr, data_ptr + size);
+    };
+    uint64_t num_of_ticks = 0;
+    for (const auto &pair: packages_id_with_data_) {
+        num_of_ticks += pair.second.size();
+    }
+    for (const auto &pair: packages_id_with_columns_) {
+        num_of_ticks += pair.second.size();
+    }
+    bytes.reserve(binary_log_sidecar_index_header.size() + kSidecarIndexKeySize + 2 +
+                  (packages_id_with_data_.size() + packages_id_with_columns_.size()) * kSidecarIndexPackageSize + num_of_ticks * kSidecarIndexTickSize + 4);
+
+    // Key of log file.
+    const uint32_t header_hash = Crc32cBytes(mapped_file_r_.data(), static_cast<uint32_t>(index_in_file_of_content_), 0);
+    write_bytes(binary_log_sidecar_index_header.data(), binary_log_sidecar_index_header.size());
+    write_bytes(&mapped_file_r_.size(), 8);
+    write_bytes(&mapped_file_r_.modified_time_ns(), 8);
+    write_bytes(&header_hash, 4);
+
+    // Index of all packages, either loaded in ticks or in columns.
+    const uint16_t num_of_packages = static_cast<uint16_t>(packages_id_with_data_.size() + packages_id_with_columns_.size());
+    write_bytes(&num_of_packages, 2);
+    for (const auto &[package_id, package_data]: packages_id_with_data_) {
+        const uint32_t num_of_ticks_of_package = static_cast<uint32_t>(package_data.size());
+        write_bytes(&package_id, 2);
+        write_bytes(&num_of_ticks_of_package, 4);
+        for (const auto &timestamped_data: package_data) {
+            write_bytes(&timestamped_data.timestamp_s, 4);
+            write_bytes(&timestamped_data.index_in_file, 8);
+            write_bytes(&timestamped_data.size_of_all_in_file, 4);
+        }
+    }
+    for (const auto &[package_id, package_columns]: packages_id_with_columns_) {
+        const uint32_t num_of_ticks_of_package = package_columns.size();
+        write_bytes(&package_id, 2);
+        write_bytes(&num_of_ticks_of_package, 4);
+        for (uint32_t i = 0; i < num_of_ticks_of_package; ++i) {
+            write_bytes(&package_columns.timestamps_s[i], 4);
+            write_bytes(&package_columns.indices_in_file[i], 8);
+            write_bytes(&package_columns.size_of_all_in_file, 4);
+        }
+    }
+    const uint32_t check_value = Crc32cBytes(bytes.data(), static_cast<uint32_t>(bytes.size()), 0);
+    write_bytes(&check_value, 4);
+
+    // Write into a temporary file first, so a broken sidecar index will never be seen by others. Directory of log file may be read-only,
+    // and sidecar index is just not saved in that case.
+    const std::string sidecar_index_file_name = SidecarIndexFileName();
+    const std::string temporary_file_name = sidecar_index_file_name + ".tmp";
+    {
+        std::ofstream file(temporary_file_name, std::ios::binary | std::ios::trunc);
+        RETURN_FALSE_IF(!file.is_open());
+        file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+        if (!file.good()) {
+            file.close();
+            std::remove(temporary_file_name.c_str());
+            return false;
+        }
+    }
+    return std::rename(temporary_file_name.c_str(), sidecar_index_file_name.c_str()) == 0;
+}
+
+bool BinaryDataLog::LoadSidecarIndex(bool load_dynamic_package_full_data, bool load_static_package_full_data) {
+    std::ifstream file(SidecarIndexFileName(), std::ios::binary | std::ios::ate);
+    RETURN_FALSE_IF(!file.is_open());
+    std::vector<uint8_t> bytes(static_cast<uint64_t>(file.tellg()));
+    file.seekg(0);
+    RETURN_FALSE_IF(!file.read(reinterpret_cast<char *>(bytes.data()), bytes.size()));
+    const uint32_t header_size = binary_log_sidecar_index_header.size();
+    RETURN_FALSE_IF(bytes.size() < header_size + kSidecarIndexKeySize + 2 + 4);
+    RETURN_FALSE_IF(std::memcmp(bytes.data(), binary_log_sidecar_index_header.data(), header_size) != 0);
+
+    // Sidecar index is only valid for the same log file.
+    const uint8_t *data_ptr = bytes.data() + header_size;
+    const uint8_t *data_end_ptr = bytes.data() + bytes.size() - 4;
+    const auto read_bytes = [&data_ptr](void *data, const uint32_t size) {
+        std::memcpy(data, data_ptr, size);
+        data_ptr += size;
+    };
+    uint64_t size_of_log_file = 0;
+    uint64_t modified_time_ns = 0;
+    uint32_t header_hash = 0;
+    read_bytes(&size_of_log_file, 8);
+    read_bytes(&modified_time_ns, 8);
+    read_bytes(&header_hash, 4);
+    RETURN_FALSE_IF(size_of_log_file != mapped_file_r_.size() || modified_time_ns != mapped_file_r_.modified_time_ns());
+    RETURN_FALSE_IF(header_hash != Crc32cBytes(mapped_file_r_.data(), static_cast<uint32_t>(index_in_file_of_content_), 0));
+    uint32_t loaded_check_value = 0;
+    std::memcpy(&loaded_check_value, data_end_ptr, 4);
+    if (Crc32cBytes(bytes.data(), static_cast<uint32_t>(bytes.size() - 4), 0) != loaded_check_value) {
+        ReportWarn("[DataLog] Sidecar index check error : " << SidecarIndexFileName());
+        return false;
+    }
+
+    // Parse index of selected packages. Frames have been checked when the index was built, so binary data is copied without checking again.
+    const uint32_t size_of_frame_without_data = 4 + 2 + 4 + FrameCheckSize();
+    DecodedPackages decoded_packages;
+    auto &timestamp_s_range = decoded_packages.timestamp_s_range;
+    uint16_t num_of_packages = 0;
+    read_bytes(&num_of_packages, 2);
+    for (uint16_t i = 0; i < num_of_packages; ++i) {
+        RETURN_FALSE_IF(data_ptr + kSidecarIndexPackageSize > data_end_ptr);
+        uint16_t package_id = 0;
+        uint32_t num_of_ticks = 0;
+        read_bytes(&package_id, 2);
+        read_bytes(&num_of_ticks, 4);
+        RETURN_FALSE_IF(static_cast<uint64_t>(num_of_ticks) * kSidecarIndexTickSize > static_cast<uint64_t>(data_end_ptr - data_ptr));
+        const auto it = packages_id_with_objects_.find(package_id);
+        if (it == packages_id_with_objects_.end() || !IsPackageSelectedToLoad(package_id)) {
+            data_ptr += num_of_ticks * kSidecarIndexTickSize;
+            continue;
+        }
+        const uint32_t data_size = it->second->size;
+        const bool load_full_data = data_size == 0 ? load_dynamic_package_full_data : load_static_package_full_data;
+
+        // Store package with static size in columns, as scanning does.
+        if (data_size > 0 && load_full_data && load_static_package_in_columns_) {
+            auto &columns = decoded_packages.packages_id_with_columns[package_id];
+            columns.size_of_data = data_size;
+            columns.size_of_all_in_file = size_of_frame_without_data + data_size;
+            columns.timestamps_s.resize(num_of_ticks);
+            columns.indices_in_file.resize(num_of_ticks);
+            columns.data.resize(static_cast<uint64_t>(num_of_ticks) * data_size);
+            for (uint32_t j = 0; j < num_of_ticks; ++j) {
+                uint32_t size_of_all_in_file = 0;
+                read_bytes(&columns.timestamps_s[j], 4);
+                read_bytes(&columns.indices_in_file[j], 8);
+                read_bytes(&size_of_all_in_file, 4);
+                RETURN_FALSE_IF(size_of_all_in_file != columns.size_of_all_in_file || !mapped_file_r_.IsInside(columns.indices_in_file[j], size_of_all_in_file));
+                std::memcpy(columns.data.data() + static_cast<uint64_t>(j) * data_size, mapped_file_r_.data() + columns.indices_in_file[j] + 4 + 2 + 4, data_size);
+                timestamp_s_range.first = std::min(timestamp_s_range.first, columns.timestamps_s[j]);
+                timestamp_s_range.second = std::max(timestamp_s_range.second, columns.timestamps_s[j]);
+            }
+            continue;
+        }
+
+        auto &packages = decoded_packages.packages_id_with_data[package_id];
+        packages.resize(num_of_ticks);
+        for (auto &timestamped_data: packages) {
+            read_bytes(&timestamped_data.timestamp_s, 4);
+            read_bytes(&timestamped_data.index_in_file, 8);
+            read_bytes(&timestamped_data.size_of_all_in_file, 4);
+            RETURN_FALSE_IF(timestamped_data.size_of_all_in_file < size_of_frame_without_data ||
+                            !mapped_file_r_.IsInside(timestamped_data.index_in_file, timestamped_data.size_of_all_in_file));
+            RETURN_FALSE_IF(data_size > 0 && timestamped_data.size_of_all_in_file != size_of_frame_without_data + data_size);
+            if (load_full_data) {
+                const uint8_t *frame_data_ptr = mapped_file_r_.data() + timestamped_data.index_in_file + 4 + 2 + 4;
+                timestamped_data.data.assign(frame_data_ptr, frame_data_ptr + timestamped_data.size_of_all_in_file - size_of_frame_without_data);
+            }
+            timestamp_s_range.first = std::min(timestamp_s_range.first, timestamped_data.timestamp_s);
+            timestamp_s_range.second = std::max(timestamp_s_range.second, timestamped_data.timestamp_s);
+        }
+    }
+    RETURN_FALSE_IF(data_ptr != data_end_ptr);
+
+    packages_id_with_data_.clear();
+    packages_id_with_columns_.clear();
+    timestamp_s_range_of_loaded_log_ = std::make_pair(INFINITY, -INFINITY);
+    MergeDecodedPackages(decoded_packages);
+    return true;
+}
+
+}  // namespace slam_data_log
@@ -0,0 +1,96 @@
+#include "binary_data_log.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "cstring"
+
+namespace slam_data_log {
+
+namespace {
+    // Visited part of log file is released after each this size of bytes.
+    constexpr uint64_t kSizeOfVisitedBytesToRelease = 64 * 1024 * 1024;
+}  // namespace
+
+bool BinaryDataLog::VisitLogFile(const std::string &log_file_name, const PackageVisitor &visitor) {
+    // Prefetcher reads mapped log file and loaded ticks, which are replaced here.
+    StopPrefetching();
+    // Try to map log file. If last log file is not closed, it will be closed.
+    if (!mapped_file_r_.Open(log_file_name)) {
+        ReportError("[DataLog] Cannot open log file : " << log_file_name);
+        return false;
+    }
+    // Binary data cached and pyramids built from last log file are useless.
+    payload_cache_.Clear();
+    packages_id_with_item_pyramids_.clear();
+
+    // Check header.
+    RETURN_FALSE_IF_FALSE(CheckLogFileHeader());
+    // Load all registered packages information.
+    RETURN_FALSE_IF_FALSE(LoadRegisteredPackagesFromFileHead());
+    SelectPackagesToLoad();
+
+    // Nothing is stored, so loaded packages of last log file are cleared.
+    packages_id_with_data_.clear();
+    packages_id_with_columns_.clear();
+    timestamp_s_range_of_loaded_log_ = std::make_pair(INFINITY, -INFINITY);
+    mapped_file_r_.AdviseSequentialAccess();
+
+    const uint32_t check_size = FrameCheckSize();
+    uint64_t index_in_file = index_in_file_of_content_;
+    uint64_t index_in_file_of_released = 0;
+    while (mapped_file_r_.IsInside(index_in_file, 4 + 2 + 4)) {
+        const uint8_t *frame_ptr = mapped_file_r_.data() + index_in_file;
+        PackageDataView package_data_view;
+        package_data_view.index_in_file = index_in_file;
+        std::memcpy(&package_data_view.size_of_all_in_file, frame_ptr, 4);
+        std::memcpy(&package_data_view.package_id, frame_ptr + 4, 2);
+        if (package_data_view.size_of_all_in_file < 4 + 2 + 4 + check_size) {
+            ReportWarn("[DataLog] Offset to next package is broken. Index in file : " << index_in_file << ". Stop visiting.");
+            break;
+        }
+        if (!mapped_file_r_.IsInside(index_in_file, package_data_view.size_of_all_in_file)) {
+            ReportWarn("[DataLog] Log file is truncated. Index in file : " << index_in_file << ". Stop visiting.");
+            break;
+        }
+        index_in_file += package_data_view.size_of_all_in_file;
+
+        // Release visited part of log file. Frame being visited is kept.
+        if (package_data_view.index_in_file - index_in_file_of_released >= kSizeOfVisitedBytesToRelease) {
+            mapped_file_r_.ReleasePages(index_in_file_of_released, package_data_view.index_in_file - index_in_file_of_released);
+            index_in_file_of_released = package_data_view.index_in_file;
+        }
+
+        // Footer index and packages not selected are skipped by offset.
+        const uint16_t package_id = package_data_view.package_id;
+        if (package_id == kFooterIndexPackageId || !IsPackageSelectedToLoad(package_id)) {
+            continue;
+        }
+        const auto it = packages_id_with_objects_.find(package_id);
+        if (it == packages_id_with_objects_.end()) {
+            ReportWarn("[DataLog] Visit one package data failed. Package id " << package_id << " is not registered.");
+            continue;
+        }
+        package_data_view.size_of_data = package_data_view.size_of_all_in_file - 4 - 2 - 4 - check_size;
+        if (it->second->size != 0 && it->second->size != package_data_view.size_of_data) {
+            ReportWarn("[DataLog] Visit one package data failed. Data size of package id " << package_id << " is not matched. Index in file : "
+                                                                                             << package_data_view.index_in_file << ".");
+            continue;
+        }
+        if (!CheckFrameInLogFile(package_data_view.index_in_file, package_data_view.size_of_all_in_file - check_size)) {
+            ReportWarn("[DataLog] Visit one package data failed for checking byte. Index in file : " << package_data_view.index_in_file << ".");
+            continue;
+        }
+
+        std::memcpy(&package_data_view.timestamp_s, frame_ptr + 6, 4);
+        package_data_view.data = frame_ptr + 4 + 2 + 4;
+        timestamp_s_range_of_loaded_log_.first = std::min(timestamp_s_range_of_loaded_log_.first, package_data_view.timestamp_s);
+        timestamp_s_range_of_loaded_log_.second = std::max(timestamp_s_range_of_loaded_log_.second, package_data_view.timestamp_s);
+        if (!visitor(package_data_view)) {
+            break;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace slam_data_log
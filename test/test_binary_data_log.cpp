@@ -1,11 +1,23 @@
 #include "binary_data_log.h"
+#include "binary_data_log_replayer.h"
 #include "slam_log_reporter.h"
 #include "slam_operations.h"
 #include "visualizor_2d.h"
 
+#include "algorithm"
+#include "array"
+#include "atomic"
+#include "chrono"
+#include "cmath"
 #include "cstring"
 #include "dirent.h"
+#include "fcntl.h"
+#include "fstream"
 #include "iostream"
+#include "iterator"
+#include "sstream"
+#include "sys/stat.h"
+#include "thread"
 #include "unistd.h"
 #include "vector"
 
@@ -47,6 +59,27 @@ struct StateData {
     float atti_z = 0.0f;
 };
 
+struct AllTypesData {
+    uint8_t value_uint8 = 0;
+    int8_t value_int8 = 0;
+    uint16_t value_uint16 = 0;
+    int16_t value_int16 = 0;
+    uint32_t value_uint32 = 0;
+    int32_t value_int32 = 0;
+    uint64_t value_uint64 = 0;
+    int64_t value_int64 = 0;
+    float value_float = 0.0f;
+    double value_double = 0.0;
+    BinaryLog3DofVector vector;
+    BinaryLog6DofPose pose;
+};
+
+struct SequenceData {
+    uint32_t thread_index = 0;
+    uint32_t sequence = 0;
+    float value = 0.0f;
+};
+
 #pragma pack()
 
 bool GetFilesInPath(std::string dir, std::vector<std::string> &filenames) {
@@ -189,17 +222,27 @@ void RegisterAllPackages(BinaryDataLog &logger) {
     }
 }
 
-void TestCreateLog(const std::string &log_file_name) {
+void TestCreateLog(const std::string &log_file_name, bool use_async_recorder = false,
+                   FrameCheckType frame_check_type = FrameCheckType::kSummaryByte) {
     ReportInfo(YELLOW ">> Test creating binary data log." RESET_COLOR);
 
     // Create a log file.
     BinaryDataLog logger;
-    if (logger.CreateLogFile(log_file_name)) {
+    if (logger.CreateLogFile(log_file_name, frame_check_type)) {
         ReportInfo("Create a new log file.");
     } else {
         ReportError("Test failed: create a new log file.");
     }
 
+    // Use a small ring buffer, so images will wrap around it.
+    if (use_async_recorder) {
+        if (logger.EnableAsyncRecording(64 * 1024)) {
+            ReportInfo("Enable asynchronous recording.");
+        } else {
+            ReportError("Test failed: enable asynchronous recording.");
+        }
+    }
+
     RegisterAllPackages(logger);
 
     // Prepare for recording.
@@ -219,7 +262,8 @@ void TestCreateLog(const std::string &log_file_name) {
     const uint32_t max_idx_of_image_file = image_filenames.size();
     uint32_t idx_of_image_file = 0;
 
-    // Record data.
+    // Record data. Random matrices should be reproducible, so logs can be compared byte-for-byte.
+    std::srand(1);
     for (uint32_t i = 0; i < 200; ++i) {
         const float timestamp = static_cast<float>(i) * 0.2f;
         const float temp = static_cast<float>(i) / 15.0f;
@@ -302,7 +346,27 @@ void TestCreateLog(const std::string &log_file_name) {
             logger.RecordPackage(9, lines, timestamp);
         }
 
-        usleep(10000);
+        if (!use_async_recorder) {
+            usleep(10000);
+        }
+    }
+
+    if (use_async_recorder && !logger.FlushAsyncRecording()) {
+        ReportError("Test failed: flush asynchronous recording.");
+    }
+}
+
+void TestCompareLogFiles(const std::string &log_file_name, const std::string &another_log_file_name) {
+    ReportInfo(YELLOW ">> Test comparing binary data logs." RESET_COLOR);
+
+    std::ifstream file(log_file_name, std::ios::binary);
+    std::ifstream another_file(another_log_file_name, std::ios::binary);
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const std::vector<char> another_bytes((std::istreambuf_iterator<char>(another_file)), std::istreambuf_iterator<char>());
+    if (!bytes.empty() && bytes == another_bytes) {
+        ReportInfo("Log files are byte-for-byte identical, " << bytes.size() << " bytes.");
+    } else {
+        ReportError("Test failed: log files are different, " << bytes.size() << " bytes vs " << another_bytes.size() << " bytes.");
     }
 }
 
@@ -338,6 +402,1660 @@ void TestPreloadLog(const std::string &log_file_name) {
     logger.ReportAllLoadedPackages();
 }
 
+void TestCompareLoadedLogs(const std::string &log_file_name, const std::string &another_log_file_name) {
+    ReportInfo(YELLOW ">> Test comparing loaded binary data logs." RESET_COLOR);
+
+    BinaryDataLog logger;
+    BinaryDataLog another_logger;
+    if (!logger.LoadLogFile(log_file_name, true) || !another_logger.LoadLogFile(another_log_file_name, true)) {
+        ReportError("Test failed: load log files to be compared.");
+        return;
+    }
+
+    uint32_t num_of_ticks = 0;
+    for (const auto &[package_id, package_data]: logger.packages_id_with_data()) {
+        const auto it = another_logger.packages_id_with_data().find(package_id);
+        if (it == another_logger.packages_id_with_data().end() || it->second.size() != package_data.size()) {
+            ReportError("Test failed: package " << package_id << " is different in loaded logs.");
+            return;
+        }
+        for (uint32_t i = 0; i < package_data.size(); ++i) {
+            if (package_data[i].timestamp_s != it->second[i].timestamp_s || package_data[i].data != it->second[i].data) {
+                ReportError("Test failed: tick " << i << " of package " << package_id << " is different in loaded logs.");
+                return;
+            }
+        }
+        num_of_ticks += package_data.size();
+    }
+    ReportInfo("Loaded logs are identical, " << num_of_ticks << " ticks.");
+}
+
+bool IsSameIndexOfLoadedLogs(const BinaryDataLog &logger, const BinaryDataLog &another_logger) {
+    RETURN_FALSE_IF(logger.packages_id_with_data().size() != another_logger.packages_id_with_data().size());
+    for (const auto &[package_id, package_data]: logger.packages_id_with_data()) {
+        const auto it = another_logger.packages_id_with_data().find(package_id);
+        RETURN_FALSE_IF(it == another_logger.packages_id_with_data().end() || it->second.size() != package_data.size());
+        for (uint32_t i = 0; i < package_data.size(); ++i) {
+            RETURN_FALSE_IF(package_data[i].timestamp_s != it->second[i].timestamp_s);
+            RETURN_FALSE_IF(package_data[i].index_in_file != it->second[i].index_in_file);
+            RETURN_FALSE_IF(package_data[i].size_of_all_in_file != it->second[i].size_of_all_in_file);
+        }
+    }
+    return logger.timestamp_s_range_of_loaded_log() == another_logger.timestamp_s_range_of_loaded_log();
+}
+
+bool IsSameDataOfLoadedLogs(const BinaryDataLog &logger, const BinaryDataLog &another_logger) {
+    RETURN_FALSE_IF(!IsSameIndexOfLoadedLogs(logger, another_logger));
+    for (const auto &[package_id, package_data]: logger.packages_id_with_data()) {
+        const auto &another_package_data = another_logger.packages_id_with_data().at(package_id);
+        for (uint32_t i = 0; i < package_data.size(); ++i) {
+            RETURN_FALSE_IF(package_data[i].data != another_package_data[i].data);
+        }
+    }
+    return true;
+}
+
+void TestLoadLogInParallel(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test loading binary data log in parallel." RESET_COLOR);
+
+    BinaryDataLog logger;
+    if (!logger.LoadLogFile(log_file_name, true)) {
+        ReportError("Test failed: load log file.");
+        return;
+    }
+
+    // Ranges of different threads begin at different bytes of log file, result should be the same as sequential loader.
+    for (const uint32_t num_of_threads: {2, 3, 4, 7, 16}) {
+        BinaryDataLog parallel_logger;
+        parallel_logger.num_of_threads_for_loading() = num_of_threads;
+        if (!parallel_logger.LoadLogFile(log_file_name, true) || !IsSameDataOfLoadedLogs(logger, parallel_logger)) {
+            ReportError("Test failed: log file loaded by " << num_of_threads << " threads is different from sequential loader.");
+            return;
+        }
+
+        // Data of dynamic packages is not loaded, only index of them.
+        BinaryDataLog preloaded_logger;
+        BinaryDataLog parallel_preloaded_logger;
+        parallel_preloaded_logger.num_of_threads_for_loading() = num_of_threads;
+        if (!preloaded_logger.LoadLogFile(log_file_name, false) || !parallel_preloaded_logger.LoadLogFile(log_file_name, false) ||
+            !IsSameDataOfLoadedLogs(preloaded_logger, parallel_preloaded_logger)) {
+            ReportError("Test failed: index of log file loaded by " << num_of_threads << " threads is different from sequential loader.");
+            return;
+        }
+    }
+    ReportInfo("Log file loaded in parallel is the same as sequential loader.");
+}
+
+bool IsSameColumnsOfLoadedLogs(const BinaryDataLog &logger, const BinaryDataLog &columns_logger) {
+    RETURN_FALSE_IF(logger.timestamp_s_range_of_loaded_log() != columns_logger.timestamp_s_range_of_loaded_log());
+    for (const auto &[package_id, package_data]: logger.packages_id_with_data()) {
+        const auto &package_info = logger.packages_id_with_objects().at(package_id);
+        if (package_info->size == 0) {
+            // Packages with dynamic size are not stored in columns.
+            const auto it = columns_logger.packages_id_with_data().find(package_id);
+            RETURN_FALSE_IF(it == columns_logger.packages_id_with_data().end() || it->second.size() != package_data.size());
+            continue;
+        }
+
+        const auto it = columns_logger.packages_id_with_columns().find(package_id);
+        RETURN_FALSE_IF(columns_logger.packages_id_with_data().count(package_id) != 0);
+        RETURN_FALSE_IF(it == columns_logger.packages_id_with_columns().end() || it->second.size() != package_data.size());
+        const auto &columns = it->second;
+        RETURN_FALSE_IF(columns.size_of_data != package_info->size || columns.data.size() != package_data.size() * package_info->size);
+        for (uint32_t i = 0; i < package_data.size(); ++i) {
+            RETURN_FALSE_IF(package_data[i].timestamp_s != columns.timestamps_s[i]);
+            RETURN_FALSE_IF(package_data[i].index_in_file != columns.indices_in_file[i]);
+            RETURN_FALSE_IF(package_data[i].size_of_all_in_file != columns.size_of_all_in_file);
+            RETURN_FALSE_IF(!std::equal(package_data[i].data.begin(), package_data[i].data.end(), columns.data_of_tick(i)));
+        }
+    }
+    return true;
+}
+
+// Sidecar index is saved by renaming a new file, so inode tells whether it has been saved again.
+uint64_t InodeOfFile(const std::string &file_name) {
+    struct stat file_stat;
+    if (::stat(file_name.c_str(), &file_stat) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(file_stat.st_ino);
+}
+
+void TestSidecarIndex(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test reopening log file by sidecar index." RESET_COLOR);
+
+    // Sidecar index should not be saved if it is disabled.
+    const std::string sidecar_index_file_name = log_file_name + ".idx";
+    std::remove(sidecar_index_file_name.c_str());
+    BinaryDataLog scanned_logger;
+    scanned_logger.use_sidecar_index() = false;
+    if (!scanned_logger.LoadLogFile(log_file_name, true) || InodeOfFile(sidecar_index_file_name) != 0) {
+        ReportError("Test failed: load log file without sidecar index.");
+        return;
+    }
+
+    // The first loading saves sidecar index, and the following loadings reuse it without saving again.
+    BinaryDataLog logger;
+    if (!logger.LoadLogFile(log_file_name, true) || InodeOfFile(sidecar_index_file_name) == 0) {
+        ReportError("Test failed: save sidecar index.");
+        return;
+    }
+    const uint64_t inode_of_sidecar_index = InodeOfFile(sidecar_index_file_name);
+    BinaryDataLog reopened_logger;
+    BinaryDataLog reopened_index_logger;
+    BinaryDataLog reopened_columns_logger;
+    reopened_columns_logger.load_static_package_in_columns() = true;
+    if (!reopened_logger.LoadLogFile(log_file_name, true) || !IsSameDataOfLoadedLogs(scanned_logger, reopened_logger) ||
+        !reopened_index_logger.LoadLogFile(log_file_name) || !reopened_columns_logger.LoadLogFile(log_file_name, true) ||
+        !IsSameColumnsOfLoadedLogs(scanned_logger, reopened_columns_logger) || InodeOfFile(sidecar_index_file_name) != inode_of_sidecar_index) {
+        ReportError("Test failed: reopen log file by sidecar index.");
+        return;
+    }
+    for (const auto &[package_id, package_data]: reopened_index_logger.packages_id_with_data()) {
+        const bool is_dynamic = reopened_index_logger.packages_id_with_objects().at(package_id)->size == 0;
+        if (package_data.empty() || package_data.front().data.empty() != is_dynamic) {
+            ReportError("Test failed: data of package id " << package_id << " is loaded by sidecar index without full data of dynamic packages.");
+            return;
+        }
+    }
+
+    // Only selected packages are loaded from sidecar index.
+    BinaryDataLog selected_logger;
+    selected_logger.package_ids_to_load() = {1, 7};
+    if (!selected_logger.LoadLogFile(log_file_name, true) || selected_logger.packages_id_with_data().size() != 2 ||
+        selected_logger.packages_id_with_data().at(7).size() != scanned_logger.packages_id_with_data().at(7).size()) {
+        ReportError("Test failed: load selected packages by sidecar index.");
+        return;
+    }
+    ReportInfo("Reopen log file by sidecar index.");
+
+    // Sidecar index is saved again if log file is modified or sidecar index is broken.
+    ::utimensat(AT_FDCWD, log_file_name.c_str(), nullptr, 0);
+    BinaryDataLog modified_logger;
+    if (!modified_logger.LoadLogFile(log_file_name, true) || !IsSameDataOfLoadedLogs(scanned_logger, modified_logger) ||
+        InodeOfFile(sidecar_index_file_name) == inode_of_sidecar_index) {
+        ReportError("Test failed: rebuild sidecar index of modified log file.");
+        return;
+    }
+    const uint64_t inode_of_broken_sidecar_index = InodeOfFile(sidecar_index_file_name);
+    {
+        std::fstream sidecar_index_file(sidecar_index_file_name, std::ios::in | std::ios::out | std::ios::binary);
+        sidecar_index_file.seekp(100);
+        sidecar_index_file.put(0x5A);
+    }
+    BinaryDataLog broken_sidecar_logger;
+    if (!broken_sidecar_logger.LoadLogFile(log_file_name, true) || !IsSameDataOfLoadedLogs(scanned_logger, broken_sidecar_logger) ||
+        InodeOfFile(sidecar_index_file_name) == inode_of_broken_sidecar_index) {
+        ReportError("Test failed: rebuild broken sidecar index.");
+        return;
+    }
+    ReportInfo("Rebuild sidecar index of modified log file.");
+}
+
+void TestLoadLogInColumns(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test loading packages with static size in columns." RESET_COLOR);
+
+    BinaryDataLog logger;
+    if (!logger.LoadLogFile(log_file_name)) {
+        ReportError("Test failed: load log file.");
+        return;
+    }
+
+    for (const uint32_t num_of_threads: {1, 4}) {
+        BinaryDataLog columns_logger;
+        columns_logger.load_static_package_in_columns() = true;
+        columns_logger.num_of_threads_for_loading() = num_of_threads;
+        if (!columns_logger.LoadLogFile(log_file_name) || !IsSameColumnsOfLoadedLogs(logger, columns_logger)) {
+            ReportError("Test failed: packages loaded in columns by " << num_of_threads << " threads are different from loaded in ticks.");
+            return;
+        }
+    }
+    ReportInfo("Packages loaded in columns are the same as loaded in ticks.");
+}
+
+bool IsSameDataOfSelectedPackages(const BinaryDataLog &logger, const BinaryDataLog &selected_logger, const std::vector<uint16_t> &package_ids) {
+    RETURN_FALSE_IF(selected_logger.packages_id_with_data().size() != package_ids.size());
+    for (const uint16_t package_id: package_ids) {
+        const auto &package_data = logger.packages_id_with_data().at(package_id);
+        const auto it = selected_logger.packages_id_with_data().find(package_id);
+        RETURN_FALSE_IF(it == selected_logger.packages_id_with_data().end() || it->second.size() != package_data.size());
+        for (uint32_t i = 0; i < package_data.size(); ++i) {
+            RETURN_FALSE_IF(package_data[i].timestamp_s != it->second[i].timestamp_s);
+            RETURN_FALSE_IF(package_data[i].index_in_file != it->second[i].index_in_file);
+            RETURN_FALSE_IF(package_data[i].data != it->second[i].data);
+        }
+    }
+    return true;
+}
+
+void TestLoadSelectedPackages(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test loading selected packages only." RESET_COLOR);
+
+    BinaryDataLog logger;
+    BinaryDataLog indexed_logger;
+    if (!logger.LoadLogFile(log_file_name, true) || !indexed_logger.LoadLogFileIndex(log_file_name)) {
+        ReportError("Test failed: load log file.");
+        return;
+    }
+
+    // Select package with static size by id, and package with dynamic size by name.
+    const std::vector<uint16_t> package_ids = {7, 8};
+    for (const uint32_t num_of_threads: {1, 4}) {
+        BinaryDataLog selected_logger;
+        selected_logger.num_of_threads_for_loading() = num_of_threads;
+        selected_logger.package_ids_to_load() = {7};
+        selected_logger.package_names_to_load() = {"local map"};
+        if (!selected_logger.LoadLogFile(log_file_name, true) || !IsSameDataOfSelectedPackages(logger, selected_logger, package_ids)) {
+            ReportError("Test failed: selected packages loaded by " << num_of_threads << " threads are different from loading all packages.");
+            return;
+        }
+    }
+
+    BinaryDataLog selected_indexed_logger;
+    selected_indexed_logger.package_ids_to_load() = {7};
+    selected_indexed_logger.package_names_to_load() = {"local map"};
+    if (!selected_indexed_logger.LoadLogFileIndex(log_file_name) || !IsSameDataOfSelectedPackages(indexed_logger, selected_indexed_logger, package_ids)) {
+        ReportError("Test failed: index of selected packages is different from loading all packages.");
+        return;
+    }
+
+    // Nothing is loaded if selected packages are not registered.
+    BinaryDataLog unregistered_logger;
+    unregistered_logger.package_names_to_load() = {"not registered"};
+    if (!unregistered_logger.LoadLogFile(log_file_name, true) || !unregistered_logger.packages_id_with_data().empty()) {
+        ReportError("Test failed: packages not selected are loaded.");
+        return;
+    }
+    ReportInfo("Selected packages are loaded only.");
+}
+
+void TestVisitLogFile(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test visiting binary data log frame by frame." RESET_COLOR);
+
+    BinaryDataLog logger;
+    if (!logger.LoadLogFile(log_file_name, true)) {
+        ReportError("Test failed: load log file.");
+        return;
+    }
+
+    // Frames should be visited in file order, and be the same as loaded ones after sorted by timestamp.
+    BinaryDataLog visitor_logger;
+    std::unordered_map<uint16_t, std::vector<PackageDataPerTick>> packages_id_with_data;
+    uint64_t index_in_file_of_last_frame = 0;
+    bool is_in_file_order = true;
+    const bool is_visited = visitor_logger.VisitLogFile(log_file_name, [&](const PackageDataView &package_data_view) {
+        is_in_file_order = is_in_file_order && package_data_view.index_in_file > index_in_file_of_last_frame;
+        index_in_file_of_last_frame = package_data_view.index_in_file;
+        PackageDataPerTick timestamped_data;
+        timestamped_data.timestamp_s = package_data_view.timestamp_s;
+        timestamped_data.data.assign(package_data_view.data, package_data_view.data + package_data_view.size_of_data);
+        timestamped_data.index_in_file = package_data_view.index_in_file;
+        timestamped_data.size_of_all_in_file = package_data_view.size_of_all_in_file;
+        packages_id_with_data[package_data_view.package_id].emplace_back(std::move(timestamped_data));
+        return true;
+    });
+    if (!is_visited || !is_in_file_order || !visitor_logger.packages_id_with_data().empty()) {
+        ReportError("Test failed: visit log file in file order.");
+        return;
+    }
+    std::vector<uint16_t> package_ids;
+    for (auto &[package_id, package_data]: packages_id_with_data) {
+        package_ids.emplace_back(package_id);
+        std::stable_sort(package_data.begin(), package_data.end(),
+                         [](const PackageDataPerTick &tick_a, const PackageDataPerTick &tick_b) { return tick_a.timestamp_s < tick_b.timestamp_s; });
+        const auto it = logger.packages_id_with_data().find(package_id);
+        if (it == logger.packages_id_with_data().end() || it->second.size() != package_data.size()) {
+            ReportError("Test failed: visited frames of package " << package_id << " are different from loaded.");
+            return;
+        }
+        for (uint32_t i = 0; i < package_data.size(); ++i) {
+            if (package_data[i].index_in_file != it->second[i].index_in_file || package_data[i].data != it->second[i].data) {
+                ReportError("Test failed: visited frames of package " << package_id << " are different from loaded.");
+                return;
+            }
+        }
+    }
+    if (package_ids.size() != logger.packages_id_with_data().size() ||
+        visitor_logger.timestamp_s_range_of_loaded_log() != logger.timestamp_s_range_of_loaded_log()) {
+        ReportError("Test failed: visited packages are different from loaded.");
+        return;
+    }
+
+    // Visiting can be stopped early, and only selected packages are visited.
+    BinaryDataLog selected_visitor_logger;
+    selected_visitor_logger.package_ids_to_load() = {package_ids.front()};
+    uint32_t num_of_visited_frames = 0;
+    bool is_selected = true;
+    selected_visitor_logger.VisitLogFile(log_file_name, [&](const PackageDataView &package_data_view) {
+        is_selected = is_selected && package_data_view.package_id == package_ids.front();
+        return ++num_of_visited_frames < 3;
+    });
+    if (!is_selected || num_of_visited_frames != std::min<uint32_t>(3, packages_id_with_data.at(package_ids.front()).size())) {
+        ReportError("Test failed: visit selected package and stop early.");
+        return;
+    }
+    ReportInfo("Frames visited one by one are the same as loaded.");
+}
+
+void TestFollowLogFile(const std::string &log_file_name, const std::string &followed_log_file_name) {
+    ReportInfo(YELLOW ">> Test following binary data log which is being recorded." RESET_COLOR);
+
+    BinaryDataLog logger;
+    if (!logger.LoadLogFile(log_file_name, true)) {
+        ReportError("Test failed: load log file.");
+        return;
+    }
+    std::ifstream log_file(log_file_name, std::ios::binary);
+    const std::vector<char> log_file_bytes((std::istreambuf_iterator<char>(log_file)), std::istreambuf_iterator<char>());
+
+    for (const bool load_in_columns: {false, true}) {
+        // Header and registered packages are recorded before all frames.
+        std::ofstream followed_log_file(followed_log_file_name, std::ios::binary | std::ios::trunc);
+        const uint64_t size_of_file_head = 4096;
+        followed_log_file.write(log_file_bytes.data(), size_of_file_head);
+        followed_log_file.flush();
+
+        BinaryDataLog follower;
+        follower.load_static_package_in_columns() = load_in_columns;
+        uint64_t num_of_new_ticks_in_total = 0;
+        bool is_new_ticks_valid = true;
+        follower.SubscribeNewTicks([&](const uint16_t package_id, const uint32_t index_of_first_new_tick, const uint32_t num_of_new_ticks) {
+            const auto &packages_id_with_data = follower.packages_id_with_data();
+            const auto &packages_id_with_columns = follower.packages_id_with_columns();
+            const uint64_t num_of_ticks = packages_id_with_data.count(package_id) ? packages_id_with_data.at(package_id).size()
+                                                                                 : packages_id_with_columns.at(package_id).size();
+            is_new_ticks_valid = is_new_ticks_valid && num_of_new_ticks > 0 && index_of_first_new_tick + num_of_new_ticks <= num_of_ticks;
+            num_of_new_ticks_in_total += num_of_new_ticks;
+        });
+        if (!follower.FollowLogFile(followed_log_file_name, true)) {
+            ReportError("Test failed: follow log file.");
+            return;
+        }
+
+        // Append the rest of log file piece by piece, most pieces end in the middle of a frame.
+        uint64_t size_of_written = size_of_file_head;
+        std::srand(1);
+        while (size_of_written < log_file_bytes.size()) {
+            const uint64_t size_to_write = std::min<uint64_t>(log_file_bytes.size() - size_of_written, 1 + std::rand() % 40000);
+            followed_log_file.write(log_file_bytes.data() + size_of_written, size_to_write);
+            followed_log_file.flush();
+            size_of_written += size_to_write;
+            if (!follower.RefreshFollowedLogFile()) {
+                ReportError("Test failed: refresh followed log file.");
+                return;
+            }
+        }
+
+        uint64_t num_of_ticks_in_total = 0;
+        for (const auto &pair: logger.packages_id_with_data()) {
+            num_of_ticks_in_total += pair.second.size();
+        }
+        const bool is_same_as_loaded = load_in_columns ? IsSameColumnsOfLoadedLogs(logger, follower) : IsSameDataOfLoadedLogs(logger, follower);
+        if (!is_same_as_loaded || !is_new_ticks_valid || num_of_new_ticks_in_total != num_of_ticks_in_total) {
+            ReportError("Test failed: followed log file is different from loaded one.");
+            return;
+        }
+    }
+
+    // Followed log file cannot be truncated.
+    BinaryDataLog follower;
+    std::ofstream(followed_log_file_name, std::ios::binary | std::ios::trunc).write(log_file_bytes.data(), log_file_bytes.size());
+    if (!follower.FollowLogFile(followed_log_file_name)) {
+        ReportError("Test failed: follow log file.");
+        return;
+    }
+    std::ofstream(followed_log_file_name, std::ios::binary | std::ios::trunc).write(log_file_bytes.data(), log_file_bytes.size() / 2);
+    if (follower.RefreshFollowedLogFile() || follower.IsFollowing()) {
+        ReportError("Test failed: truncated log file is still followed.");
+        return;
+    }
+    ReportInfo("Followed log file is the same as loaded one.");
+}
+
+void TestFollowOutOfOrderTicks(const std::string &followed_log_file_name) {
+    ReportInfo(YELLOW ">> Test following binary data log with out-of-order ticks." RESET_COLOR);
+
+    // Ticks in the second half of log file are recorded between ticks in the first half.
+    const std::string csv_file_name = followed_log_file_name + ".csv";
+    const std::string log_file_name = followed_log_file_name + ".out_of_order";
+    {
+        std::ofstream csv_file(csv_file_name, std::ios::trunc);
+        csv_file << "timestamp_s,imu/value\n";
+        for (uint32_t i = 0; i < 2000; ++i) {
+            csv_file << i << "," << std::sin(i * 0.1) << "\n";
+        }
+        for (uint32_t i = 0; i < 2000; ++i) {
+            csv_file << i + 0.5 << "," << std::cos(i * 0.1) * 2.0 << "\n";
+        }
+    }
+    BinaryDataLog logger;
+    if (!BinaryDataLog::CreateLogFileByCsvFile(csv_file_name, log_file_name) || !logger.LoadLogFile(log_file_name)) {
+        ReportError("Test failed: create log file with out-of-order ticks.");
+        return;
+    }
+    std::ifstream log_file(log_file_name, std::ios::binary);
+    const std::vector<char> log_file_bytes((std::istreambuf_iterator<char>(log_file)), std::istreambuf_iterator<char>());
+
+    // Buckets queried before out-of-order ticks are followed should not be reused after ticks are sorted again.
+    std::ofstream followed_log_file(followed_log_file_name, std::ios::binary | std::ios::trunc);
+    followed_log_file.write(log_file_bytes.data(), log_file_bytes.size() * 2 / 5);
+    followed_log_file.flush();
+    BinaryDataLog follower;
+    std::vector<std::vector<TimeSeriesBucket>> followed_buckets;
+    std::vector<std::vector<TimeSeriesBucket>> loaded_buckets;
+    if (!follower.FollowLogFile(followed_log_file_name) || !follower.QueryItemBuckets(1, "value", 0.0f, 2000.0f, 100, followed_buckets)) {
+        ReportError("Test failed: query buckets of followed log file.");
+        return;
+    }
+    followed_log_file.write(log_file_bytes.data() + log_file_bytes.size() * 2 / 5, log_file_bytes.size() - log_file_bytes.size() * 2 / 5);
+    followed_log_file.flush();
+    follower.RefreshFollowedLogFile();
+    if (!follower.QueryItemBuckets(1, "value", 0.0f, 2000.0f, 100, followed_buckets) ||
+        !logger.QueryItemBuckets(1, "value", 0.0f, 2000.0f, 100, loaded_buckets) || followed_buckets.size() != loaded_buckets.size() ||
+        follower.packages_id_with_data().at(1).size() != 4000) {
+        ReportError("Test failed: query buckets of followed log file with out-of-order ticks.");
+        return;
+    }
+    for (uint32_t i = 0; i < loaded_buckets.size(); ++i) {
+        const auto &followed = followed_buckets[i];
+        const auto &loaded = loaded_buckets[i];
+        for (uint32_t j = 0; j < loaded.size(); ++j) {
+            if (followed.size() != loaded.size() || followed[j].num_of_samples != loaded[j].num_of_samples ||
+                followed[j].min_value != loaded[j].min_value || followed[j].max_value != loaded[j].max_value ||
+                followed[j].mean_value != loaded[j].mean_value || followed[j].timestamp_s_begin != loaded[j].timestamp_s_begin) {
+                ReportError("Test failed: bucket " << j << " of followed log file is different from loaded one.");
+                return;
+            }
+        }
+    }
+    ReportInfo("Buckets of followed log file with out-of-order ticks are the same as loaded one.");
+}
+
+template <typename T>
+bool IsSameColumnsAsConvertBytes(const BinaryDataLog &logger, const PackageInfo &package_info, const std::vector<const uint8_t *> &ticks) {
+    for (const auto &item: package_info.items) {
+        std::vector<std::vector<T>> columns;
+        RETURN_FALSE_IF(!logger.ExtractItemColumns(package_info.id, item.name, columns));
+
+        // Components of kVector3 and kPose6Dof are float.
+        const bool is_expanded = item.type == ItemType::kVector3 || item.type == ItemType::kPose6Dof;
+        const ItemType type = is_expanded ? ItemType::kFloat : item.type;
+        const uint32_t num_of_components = is_expanded ? item_type_sizes[static_cast<uint32_t>(item.type)] / sizeof(float) : 1;
+        RETURN_FALSE_IF(columns.size() != num_of_components);
+        for (uint32_t i = 0; i < num_of_components; ++i) {
+            RETURN_FALSE_IF(columns[i].size() != ticks.size());
+            for (uint32_t j = 0; j < ticks.size(); ++j) {
+                const T value = BinaryDataLog::ConvertBytes<T>(ticks[j] + item.bindata_index_in_package + i * sizeof(float), type);
+                RETURN_FALSE_IF(columns[i][j] != value);
+            }
+        }
+    }
+    return true;
+}
+
+void TestExtractItemColumns(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test extracting columns of items." RESET_COLOR);
+
+    // Record a package with items of all static types. Number of ticks is not aligned with width of simd kernels.
+    constexpr uint16_t kPackageId = 1;
+    constexpr uint32_t kNumOfTicks = 1003;
+    {
+        BinaryDataLog logger;
+        RETURN_IF(!logger.CreateLogFile(log_file_name));
+        std::unique_ptr<PackageInfo> package_ptr = std::make_unique<PackageInfo>();
+        package_ptr->id = kPackageId;
+        package_ptr->name = "all types";
+        for (uint32_t i = 0; i <= static_cast<uint32_t>(ItemType::kPose6Dof); ++i) {
+            package_ptr->items.emplace_back(PackageItemInfo {.type = static_cast<ItemType>(i), .name = item_type_strings[i]});
+        }
+        RETURN_IF(!logger.RegisterPackage(package_ptr));
+        RETURN_IF(!logger.PrepareForRecording());
+
+        std::srand(1);
+        for (uint32_t i = 0; i < kNumOfTicks; ++i) {
+            const int32_t value = std::rand() - RAND_MAX / 2;
+            AllTypesData data;
+            data.value_uint8 = static_cast<uint8_t>(value);
+            data.value_int8 = static_cast<int8_t>(value);
+            data.value_uint16 = static_cast<uint16_t>(value);
+            data.value_int16 = static_cast<int16_t>(value);
+            data.value_uint32 = static_cast<uint32_t>(value) * 3u;
+            data.value_int32 = value;
+            data.value_uint64 = static_cast<uint64_t>(value) * 12345678901ull;
+            data.value_int64 = static_cast<int64_t>(value) * 12345678901ll;
+            data.value_float = static_cast<float>(value) * 1e-3f;
+            data.value_double = static_cast<double>(value) * 1e-7;
+            data.vector = BinaryLog3DofVector {.x = value * 1e-2f, .y = -value * 1e-3f, .z = value * 1e-4f};
+            data.pose = BinaryLog6DofPose {.p_x = value * 1e-2f, .p_y = 1.0f, .p_z = 2.0f, .q_w = 0.5f, .q_x = -0.5f, .q_y = value * 1e-9f, .q_z = 0.5f};
+            RETURN_IF(!logger.RecordPackage(kPackageId, reinterpret_cast<const char *>(&data), static_cast<float>(i) * 1e-2f));
+        }
+    }
+
+    // Columns extracted from ticks and from columns store should be both the same as converting each tick.
+    for (const bool load_in_columns: {false, true}) {
+        BinaryDataLog logger;
+        logger.load_static_package_in_columns() = load_in_columns;
+        if (!logger.LoadLogFile(log_file_name)) {
+            ReportError("Test failed: load log file.");
+            return;
+        }
+
+        std::vector<const uint8_t *> ticks;
+        if (load_in_columns) {
+            const auto &columns = logger.packages_id_with_columns().at(kPackageId);
+            for (uint32_t i = 0; i < columns.size(); ++i) {
+                ticks.emplace_back(columns.data_of_tick(i));
+            }
+        } else {
+            for (const auto &timestamped_data: logger.packages_id_with_data().at(kPackageId)) {
+                ticks.emplace_back(timestamped_data.data.data());
+            }
+        }
+
+        const PackageInfo &package_info = *logger.packages_id_with_objects().at(kPackageId);
+        std::vector<float> timestamps_s;
+        if (ticks.size() != kNumOfTicks || !logger.ExtractTimestampColumn(kPackageId, timestamps_s) || timestamps_s.size() != kNumOfTicks ||
+            !IsSameColumnsAsConvertBytes<float>(logger, package_info, ticks) || !IsSameColumnsAsConvertBytes<double>(logger, package_info, ticks)) {
+            ReportError("Test failed: columns extracted from " << (load_in_columns ? "columns" : "ticks") << " are different from converting each tick.");
+            return;
+        }
+
+        // Items with dynamic size or expanded into several components cannot be extracted as one column.
+        std::vector<float> column;
+        if (logger.ExtractItemColumn(kPackageId, "kPose6Dof", column) || !logger.ExtractItemColumn(kPackageId, "kInt16", column)) {
+            ReportError("Test failed: extract one column of item.");
+            return;
+        }
+    }
+    ReportInfo("Columns extracted are the same as converting each tick.");
+}
+
+bool IsDecodedValueAccurate(const float value, const float scalar_value, const float max_error) {
+    if (std::isnan(scalar_value)) {
+        return std::isnan(value);
+    }
+    return std::fabs(value - scalar_value) <= max_error;
+}
+
+void TestDecodeColumns(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test decoding columns in batch." RESET_COLOR);
+
+    // Random quaternions, including not normalized ones and special ones on boundary of quadrant.
+    std::vector<std::array<float, 4>> quaternions = {
+        {1.0f, 0.0f, 0.0f, 0.0f},   {0.0f, 1.0f, 0.0f, 0.0f},    {0.0f, 0.0f, 1.0f, 0.0f},   {0.0f, 0.0f, 0.0f, 1.0f},    {0.0f, 0.0f, 0.0f, 0.0f},
+        {0.5f, 0.5f, 0.5f, 0.5f},   {0.5f, -0.5f, 0.5f, -0.5f},  {-0.5f, 0.5f, 0.5f, 0.5f},  {0.7071068f, 0.0f, 0.7071068f, 0.0f},
+        {0.7071068f, 0.0f, -0.7071068f, 0.0f}, {-1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, -1.0f, 0.0f, 0.0f}, {2.0f, 1.0f, -3.0f, 0.5f},
+    };
+    std::srand(1);
+    for (uint32_t i = 0; i < 100000; ++i) {
+        std::array<float, 4> q;
+        for (auto &value: q) {
+            value = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX) * 2.0f - 1.0f;
+        }
+        const float norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        if (i % 10 != 0 && norm > 0.0f) {
+            for (auto &value: q) {
+                value /= norm;
+            }
+        }
+        quaternions.emplace_back(q);
+    }
+    std::vector<std::vector<float>> components(4, std::vector<float>(quaternions.size()));
+    for (uint32_t i = 0; i < quaternions.size(); ++i) {
+        for (uint32_t j = 0; j < 4; ++j) {
+            components[j][i] = quaternions[i][j];
+        }
+    }
+
+    // Angles are in degree, and error of float is about 1e-5 degree near 180 degree.
+    const std::vector<std::pair<DecodeType, float>> decoders_with_max_error = {
+        {DecodeType::kQuaternionToRoll, 1e-3f}, {DecodeType::kQuaternionToPitch, 1e-3f}, {DecodeType::kQuaternionToYaw, 1e-3f},
+        {DecodeType::kVector2dToMod, 1e-6f},    {DecodeType::kVector3dToMod, 1e-6f},
+    };
+    for (const auto &[decoder, max_error]: decoders_with_max_error) {
+        std::vector<float> values;
+        if (!BinaryDataLog::DecodeColumns(components, decoder, values) || values.size() != quaternions.size()) {
+            ReportError("Test failed: decode columns by decoder " << static_cast<int32_t>(decoder) << ".");
+            return;
+        }
+        for (uint32_t i = 0; i < quaternions.size(); ++i) {
+            const float scalar_value = BinaryDataLog::ConvertBytes<float>(reinterpret_cast<const uint8_t *>(quaternions[i].data()), ItemType::kFloat, decoder);
+            if (!IsDecodedValueAccurate(values[i], scalar_value, max_error)) {
+                ReportError("Test failed: decoder " << static_cast<int32_t>(decoder) << " of tick " << i << " is " << values[i] << ", but scalar one is "
+                                                    << scalar_value << ".");
+                return;
+            }
+        }
+    }
+
+    // Items of kPose6Dof and kVector3 can be decoded directly.
+    BinaryDataLog logger;
+    logger.load_static_package_in_columns() = true;
+    if (!logger.LoadLogFile(log_file_name)) {
+        ReportError("Test failed: load log file.");
+        return;
+    }
+    const auto &package_columns = logger.packages_id_with_columns().begin()->second;
+    const uint16_t package_id = logger.packages_id_with_columns().begin()->first;
+    const auto &items = logger.packages_id_with_objects().at(package_id)->items;
+    for (const auto &item: items) {
+        if (item.type != ItemType::kPose6Dof && item.type != ItemType::kVector3) {
+            continue;
+        }
+        for (const auto &[decoder, max_error]: decoders_with_max_error) {
+            const bool is_quaternion_decoder = decoder <= DecodeType::kQuaternionToYaw;
+            std::vector<float> values;
+            const bool is_decoded = logger.ExtractDecodedItemColumn(package_id, item.name, decoder, values);
+            if (item.type == ItemType::kVector3 && is_quaternion_decoder) {
+                if (is_decoded) {
+                    ReportError("Test failed: quaternion is decoded from item of kVector3.");
+                    return;
+                }
+                continue;
+            }
+            if (!is_decoded || values.size() != package_columns.size()) {
+                ReportError("Test failed: decode item [" << item.name << "] by decoder " << static_cast<int32_t>(decoder) << ".");
+                return;
+            }
+            const uint32_t offset = item.type == ItemType::kPose6Dof && is_quaternion_decoder ? 3 * sizeof(float) : 0;
+            for (uint32_t i = 0; i < package_columns.size(); ++i) {
+                const uint8_t *bytes = package_columns.data_of_tick(i) + item.bindata_index_in_package + offset;
+                if (!IsDecodedValueAccurate(values[i], BinaryDataLog::ConvertBytes<float>(bytes, ItemType::kFloat, decoder), max_error * 1e3f)) {
+                    ReportError("Test failed: decoded item [" << item.name << "] by decoder " << static_cast<int32_t>(decoder) << " is not accurate.");
+                    return;
+                }
+            }
+        }
+    }
+    ReportInfo("Columns decoded in batch are accurate.");
+}
+
+void TestQueryTicksInTimeRange(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test querying ticks in time range." RESET_COLOR);
+
+    for (const bool load_in_columns: {false, true}) {
+        BinaryDataLog logger;
+        logger.load_static_package_in_columns() = load_in_columns;
+        if (!logger.LoadLogFile(log_file_name, true)) {
+            ReportError("Test failed: load log file.");
+            return;
+        }
+
+        // Collect timestamps of all loaded packages. They should be sorted after loading.
+        std::vector<std::pair<uint16_t, std::vector<float>>> packages_id_with_timestamps;
+        for (const auto &[package_id, package_data]: logger.packages_id_with_data()) {
+            std::vector<float> timestamps_s;
+            for (const auto &tick: package_data) {
+                timestamps_s.emplace_back(tick.timestamp_s);
+            }
+            packages_id_with_timestamps.emplace_back(package_id, timestamps_s);
+        }
+        for (const auto &[package_id, package_columns]: logger.packages_id_with_columns()) {
+            packages_id_with_timestamps.emplace_back(package_id, package_columns.timestamps_s);
+        }
+        std::vector<uint16_t> package_ids;
+        for (const auto &[package_id, timestamps_s]: packages_id_with_timestamps) {
+            package_ids.emplace_back(package_id);
+            if (!std::is_sorted(timestamps_s.begin(), timestamps_s.end())) {
+                ReportError("Test failed: ticks of package " << package_id << " are not sorted by timestamp.");
+                return;
+            }
+        }
+
+        // Query random time ranges, and compare with ticks filtered by hand.
+        const auto &time_range = logger.timestamp_s_range_of_loaded_log();
+        std::srand(1);
+        for (uint32_t i = 0; i < 200; ++i) {
+            const float time_stamp_s_a = time_range.first + (time_range.second - time_range.first) * std::rand() / RAND_MAX;
+            const float time_stamp_s_b = i % 10 == 0 ? time_stamp_s_a : time_range.first + (time_range.second - time_range.first) * std::rand() / RAND_MAX;
+            const float time_stamp_s_begin = std::min(time_stamp_s_a, time_stamp_s_b);
+            const float time_stamp_s_end = std::max(time_stamp_s_a, time_stamp_s_b);
+            for (const auto &[package_id, timestamps_s]: packages_id_with_timestamps) {
+                uint32_t index_of_begin_tick = 0;
+                uint32_t index_of_end_tick = 0;
+                std::vector<PackageDataPerTick> ticks;
+                if (!logger.Query(package_id, time_stamp_s_begin, time_stamp_s_end, index_of_begin_tick, index_of_end_tick) ||
+                    !logger.Query(package_id, time_stamp_s_begin, time_stamp_s_end, ticks) || ticks.size() != index_of_end_tick - index_of_begin_tick) {
+                    ReportError("Test failed: query package " << package_id << ".");
+                    return;
+                }
+                for (uint32_t j = 0; j < timestamps_s.size(); ++j) {
+                    const bool is_in_range = timestamps_s[j] >= time_stamp_s_begin && timestamps_s[j] <= time_stamp_s_end;
+                    if (is_in_range != (j >= index_of_begin_tick && j < index_of_end_tick)) {
+                        ReportError("Test failed: queried ticks of package " << package_id << " in [" << time_stamp_s_begin << ", " << time_stamp_s_end
+                                                                              << "] are wrong.");
+                        return;
+                    }
+                }
+                for (uint32_t j = 0; j < ticks.size(); ++j) {
+                    if (ticks[j].timestamp_s != timestamps_s[index_of_begin_tick + j]) {
+                        ReportError("Test failed: queried ticks of package " << package_id << " are not copied.");
+                        return;
+                    }
+                }
+            }
+
+            // Nearest tick of each package should have the minimum time difference.
+            std::vector<uint32_t> indices_of_ticks;
+            if (!logger.QueryNearestTicks(package_ids, time_stamp_s_a, indices_of_ticks) || indices_of_ticks.size() != package_ids.size()) {
+                ReportError("Test failed: query nearest ticks.");
+                return;
+            }
+            for (uint32_t j = 0; j < package_ids.size(); ++j) {
+                const auto &timestamps_s = packages_id_with_timestamps[j].second;
+                const float nearest_time_diff = std::fabs(timestamps_s[indices_of_ticks[j]] - time_stamp_s_a);
+                for (const float timestamp_s: timestamps_s) {
+                    if (std::fabs(timestamp_s - time_stamp_s_a) < nearest_time_diff) {
+                        ReportError("Test failed: nearest tick of package " << package_ids[j] << " at " << time_stamp_s_a << " is wrong.");
+                        return;
+                    }
+                }
+            }
+        }
+
+        // Package not loaded cannot be queried.
+        uint32_t index_of_begin_tick = 0;
+        uint32_t index_of_end_tick = 0;
+        std::vector<uint32_t> indices_of_ticks;
+        if (logger.Query(kFooterIndexPackageId, 0.0f, 1.0f, index_of_begin_tick, index_of_end_tick) ||
+            logger.QueryNearestTicks({kFooterIndexPackageId}, 0.0f, indices_of_ticks)) {
+            ReportError("Test failed: query package which is not loaded.");
+            return;
+        }
+    }
+    ReportInfo("Ticks queried in time range are correct.");
+}
+
+void TestQueryItemBuckets(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test querying buckets of item in time range." RESET_COLOR);
+
+    BinaryDataLog logger;
+    std::vector<float> timestamps_s;
+    std::vector<std::vector<float>> columns;
+    if (!logger.LoadLogFile(log_file_name) || !logger.ExtractTimestampColumn(1, timestamps_s) || !logger.ExtractItemColumns(1, "gyro", columns)) {
+        ReportError("Test failed: load log file and extract columns.");
+        return;
+    }
+
+    // Each bucket should summarize samples between its first and last timestamps, for plots of different width.
+    const auto &time_range = logger.timestamp_s_range_of_loaded_log();
+    const float time_stamp_s_begin = time_range.first + (time_range.second - time_range.first) * 0.1f;
+    const float time_stamp_s_end = time_range.first + (time_range.second - time_range.first) * 0.7f;
+    uint32_t num_of_samples_in_range = 0;
+    for (const float timestamp_s: timestamps_s) {
+        num_of_samples_in_range += timestamp_s >= time_stamp_s_begin && timestamp_s <= time_stamp_s_end;
+    }
+    for (const uint32_t num_of_buckets: {1u, 7u, 30u, 1000u}) {
+        std::vector<std::vector<TimeSeriesBucket>> buckets_of_components;
+        if (!logger.QueryItemBuckets(1, "gyro", time_stamp_s_begin, time_stamp_s_end, num_of_buckets, buckets_of_components) ||
+            buckets_of_components.size() != columns.size()) {
+            ReportError("Test failed: query buckets of item.");
+            return;
+        }
+        for (uint32_t i = 0; i < columns.size(); ++i) {
+            const auto &buckets = buckets_of_components[i];
+            const uint32_t min_num_of_buckets = std::min(num_of_buckets, num_of_samples_in_range);
+            if (buckets.size() < min_num_of_buckets || buckets.size() > num_of_buckets * BinaryDataLogItemPyramid::kBranchFactor + 2 ||
+                buckets.front().timestamp_s_begin > time_stamp_s_begin + 0.5f || buckets.back().timestamp_s_end < time_stamp_s_end - 0.5f) {
+                ReportError("Test failed: query " << buckets.size() << " buckets for plot of width " << num_of_buckets << ".");
+                return;
+            }
+            for (const auto &bucket: buckets) {
+                float min_value = INFINITY;
+                float max_value = -INFINITY;
+                double sum_of_values = 0.0;
+                uint32_t num_of_samples = 0;
+                for (uint32_t j = 0; j < timestamps_s.size(); ++j) {
+                    CONTINUE_IF(timestamps_s[j] < bucket.timestamp_s_begin || timestamps_s[j] > bucket.timestamp_s_end);
+                    min_value = std::min(min_value, columns[i][j]);
+                    max_value = std::max(max_value, columns[i][j]);
+                    sum_of_values += columns[i][j];
+                    ++num_of_samples;
+                }
+                if (bucket.num_of_samples != num_of_samples || bucket.min_value != min_value || bucket.max_value != max_value ||
+                    std::fabs(bucket.mean_value - sum_of_values / num_of_samples) > 1e-5f) {
+                    ReportError("Test failed: bucket [" << bucket.timestamp_s_begin << ", " << bucket.timestamp_s_end << "] is different from samples.");
+                    return;
+                }
+            }
+        }
+        ReportInfo("Query " << buckets_of_components.front().size() << " buckets of " << num_of_samples_in_range << " samples for plot of width "
+                            << num_of_buckets << ".");
+    }
+
+    // Pyramid built by appending samples in pieces should be the same as building at once.
+    BinaryDataLogItemPyramid pyramid;
+    BinaryDataLogItemPyramid appended_pyramid;
+    pyramid.Append(timestamps_s.data(), columns[0].data(), timestamps_s.size());
+    for (uint32_t i = 0; i < timestamps_s.size(); i += 13) {
+        appended_pyramid.Append(timestamps_s.data() + i, columns[0].data() + i, std::min<uint32_t>(13, timestamps_s.size() - i));
+    }
+    // Samples are not copied into pyramid, and level 0 merges kBranchFactor samples per bucket.
+    const uint64_t num_of_first_level_buckets = (timestamps_s.size() + BinaryDataLogItemPyramid::kBranchFactor - 1) / BinaryDataLogItemPyramid::kBranchFactor;
+    if (pyramid.num_of_levels() != appended_pyramid.num_of_levels() || pyramid.level(0).size() != num_of_first_level_buckets ||
+        appended_pyramid.num_of_samples() != timestamps_s.size()) {
+        ReportError("Test failed: levels of appended pyramid are different.");
+        return;
+    }
+    for (uint32_t i = 0; i < pyramid.num_of_levels(); ++i) {
+        if (pyramid.level(i).size() != appended_pyramid.level(i).size() ||
+            std::memcmp(pyramid.level(i).data(), appended_pyramid.level(i).data(), pyramid.level(i).size() * sizeof(TimeSeriesBucket)) != 0) {
+            ReportError("Test failed: level " << i << " of appended pyramid is different.");
+            return;
+        }
+    }
+    ReportInfo("Pyramid of " << pyramid.num_of_levels() << " levels is the same after appending.");
+}
+
+void TestLoadLogIndex(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test loading index of binary data log." RESET_COLOR);
+
+    BinaryDataLog scanned_logger;
+    BinaryDataLog indexed_logger;
+    if (!scanned_logger.LoadLogFile(log_file_name) || !indexed_logger.LoadLogFileIndex(log_file_name)) {
+        ReportError("Test failed: load index of log file.");
+        return;
+    }
+    if (IsSameIndexOfLoadedLogs(scanned_logger, indexed_logger)) {
+        ReportInfo("Index loaded from footer is the same as scanning the whole log file.");
+    } else {
+        ReportError("Test failed: index loaded from footer is different from scanning the whole log file.");
+    }
+
+    // Truncate the footer index, then index should be loaded by scanning the whole log file.
+    const std::string truncated_log_file_name = log_file_name + ".truncated";
+    {
+        std::ifstream file(log_file_name, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        std::ofstream truncated_file(truncated_log_file_name, std::ios::binary);
+        truncated_file.write(bytes.data(), bytes.size() - 5);
+    }
+    BinaryDataLog truncated_logger;
+    if (truncated_logger.LoadLogFileIndex(truncated_log_file_name) && IsSameIndexOfLoadedLogs(scanned_logger, truncated_logger)) {
+        ReportInfo("Index of truncated log file is loaded by scanning the whole log file.");
+    } else {
+        ReportError("Test failed: load index of truncated log file.");
+    }
+}
+
+void TestLoadBrokenDynamicPackage(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test loading dynamic package with broken size." RESET_COLOR);
+
+    constexpr uint16_t kPointCloudPackageId = 8;
+    BinaryDataLog scanned_logger;
+    scanned_logger.use_sidecar_index() = false;
+    if (!scanned_logger.LoadLogFile(log_file_name) || scanned_logger.packages_id_with_data().at(kPointCloudPackageId).size() < 2) {
+        ReportError("Test failed: load log file.");
+        return;
+    }
+    const auto &point_clouds = scanned_logger.packages_id_with_data().at(kPointCloudPackageId);
+
+    // Number of points is increased by 2^30, so its size wraps to the same 32 bits value. Summary byte is kept by changing the first point.
+    const std::string broken_log_file_name = log_file_name + ".broken";
+    const uint64_t index_in_file_of_data = point_clouds[1].index_in_file + 4 + 2 + 4;
+    {
+        std::ifstream file(log_file_name, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        bytes[index_in_file_of_data + 3] = static_cast<char>(bytes[index_in_file_of_data + 3] + 0x40);
+        bytes[index_in_file_of_data + 4] = static_cast<char>(bytes[index_in_file_of_data + 4] - 0x40);
+        std::ofstream broken_file(broken_log_file_name, std::ios::binary);
+        broken_file.write(bytes.data(), bytes.size());
+    }
+    BinaryDataLog broken_logger;
+    broken_logger.use_sidecar_index() = false;
+    if (!broken_logger.LoadLogFile(broken_log_file_name)) {
+        ReportError("Test failed: load log file with broken size of point cloud.");
+        return;
+    }
+    const auto &loaded_point_clouds = broken_logger.packages_id_with_data().at(kPointCloudPackageId);
+    const bool is_broken_loaded = std::any_of(loaded_point_clouds.begin(), loaded_point_clouds.end(),
+                                              [&](const PackageDataPerTick &tick) { return tick.index_in_file == point_clouds[1].index_in_file; });
+    if (!is_broken_loaded && loaded_point_clouds.size() + 1 == point_clouds.size()) {
+        ReportInfo("Point cloud with broken size is skipped, and others are loaded.");
+    } else {
+        ReportError("Test failed: point cloud with broken size is loaded.");
+    }
+}
+
+void TestLoadBinaryDataViewFromLogFile(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test loading binary data views with payload cache." RESET_COLOR);
+
+    BinaryDataLog logger;
+    if (!logger.LoadLogFile(log_file_name, true)) {
+        ReportError("Test failed: load log file.");
+        return;
+    }
+
+    // Each data is viewed twice, the second view should be found in cache without copy.
+    std::vector<const PackageDataPerTick *> ticks;
+    uint64_t size_of_all_data = 0;
+    for (const auto &[package_id, package_data]: logger.packages_id_with_data()) {
+        for (const auto &timestamped_data: package_data) {
+            if (!timestamped_data.data.empty()) {
+                ticks.emplace_back(&timestamped_data);
+                size_of_all_data += timestamped_data.data.size();
+            }
+        }
+    }
+    logger.payload_cache().SetSizeBudget(size_of_all_data);
+    for (const auto tick: ticks) {
+        const BinaryDataView view = logger.LoadBinaryDataViewFromLogFile(tick->index_in_file + 4 + 2 + 4, tick->data.size());
+        const BinaryDataView cached_view = logger.LoadBinaryDataViewFromLogFile(tick->index_in_file + 4 + 2 + 4, tick->data.size());
+        if (view.size() != tick->data.size() || !std::equal(view.begin(), view.end(), tick->data.begin()) || cached_view.data() != view.data()) {
+            ReportError("Test failed: binary data view is different from loaded log file.");
+            return;
+        }
+    }
+    auto statistics = logger.payload_cache().statistics();
+    if (statistics.num_of_hits != ticks.size() || statistics.num_of_misses != ticks.size() || statistics.num_of_evictions != 0 ||
+        statistics.size_of_cached_bytes != size_of_all_data || statistics.num_of_cached_items != ticks.size()) {
+        ReportError("Test failed: statistics of payload cache is wrong.");
+        return;
+    }
+
+    // Least recently used data is evicted when budget is reduced, but it is still alive for its views.
+    const PackageDataPerTick &first_tick = *ticks.front();
+    const BinaryDataView first_view = logger.LoadBinaryDataViewFromLogFile(first_tick.index_in_file + 4 + 2 + 4, first_tick.data.size());
+    logger.payload_cache().SetSizeBudget(first_tick.data.size());
+    statistics = logger.payload_cache().statistics();
+    if (statistics.num_of_cached_items != 1 || statistics.num_of_evictions != ticks.size() - 1 ||
+        logger.payload_cache().Find(first_tick.index_in_file + 4 + 2 + 4, first_tick.data.size()).data() != first_view.data()) {
+        ReportError("Test failed: least recently used data is not evicted.");
+        return;
+    }
+    logger.payload_cache().Clear();
+    if (!std::equal(first_view.begin(), first_view.end(), first_tick.data.begin())) {
+        ReportError("Test failed: evicted data is not alive for its view.");
+        return;
+    }
+
+    // Binary data out of log file cannot be viewed.
+    if (!logger.LoadBinaryDataViewFromLogFile(logger.mapped_file_r().size() - 4, 5).empty()) {
+        ReportError("Test failed: binary data out of log file is viewed.");
+        return;
+    }
+    ReportInfo("Binary data views with payload cache are the same as loaded log file.");
+}
+
+void TestLoadBinaryDataViewsInParallel(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test loading binary data views by multiple threads." RESET_COLOR);
+
+    // Each data is requested several times, so threads may view the same data in payload cache at the same time.
+    BinaryDataLog logger;
+    if (!logger.LoadLogFile(log_file_name, true)) {
+        ReportError("Test failed: load log file.");
+        return;
+    }
+    std::vector<const PackageDataPerTick *> ticks;
+    std::vector<std::pair<uint64_t, uint32_t>> requests;
+    for (uint32_t i = 0; i < 3; ++i) {
+        for (const auto &[package_id, package_data]: logger.packages_id_with_data()) {
+            for (const auto &timestamped_data: package_data) {
+                ticks.emplace_back(&timestamped_data);
+                requests.emplace_back(timestamped_data.index_in_file + 4 + 2 + 4, timestamped_data.data.size());
+            }
+        }
+    }
+
+    for (const uint32_t num_of_threads: {1, 4, 16}) {
+        logger.num_of_threads_for_loading() = num_of_threads;
+        logger.payload_cache().Clear();
+        std::vector<BinaryDataView> views;
+        if (!logger.LoadBinaryDataViewsFromLogFile(requests, views) || views.size() != requests.size()) {
+            ReportError("Test failed: load binary data views by " << num_of_threads << " threads.");
+            return;
+        }
+        for (uint32_t i = 0; i < views.size(); ++i) {
+            if (views[i].size() != ticks[i]->data.size() || !std::equal(views[i].begin(), views[i].end(), ticks[i]->data.begin())) {
+                ReportError("Test failed: binary data view loaded by " << num_of_threads << " threads is different from loaded log file.");
+                return;
+            }
+        }
+    }
+
+    // Binary data can also be copied by multiple threads at the same time.
+    std::atomic<bool> is_all_same = true;
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i]() {
+            for (uint32_t j = i; j < ticks.size(); j += 4) {
+                uint8_t *data_ptr = logger.LoadBinaryDataFromLogFile(requests[j].first, requests[j].second);
+                is_all_same = is_all_same && data_ptr != nullptr && std::equal(ticks[j]->data.begin(), ticks[j]->data.end(), data_ptr);
+                delete[] data_ptr;
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    if (!is_all_same) {
+        ReportError("Test failed: binary data loaded by multiple threads is different from loaded log file.");
+        return;
+    }
+
+    // Request out of log file fails, but other requests are still loaded.
+    std::vector<BinaryDataView> views;
+    if (logger.LoadBinaryDataViewsFromLogFile({requests.front(), {logger.mapped_file_r().size() - 4, 5}}, views) || views.size() != 2 ||
+        views.front().size() != requests.front().second || !views.back().empty()) {
+        ReportError("Test failed: request out of log file is loaded.");
+        return;
+    }
+    ReportInfo("Binary data views loaded by multiple threads are the same as loaded log file.");
+}
+
+void TestPrefetchPayloads(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test prefetching payloads near playback time." RESET_COLOR);
+
+    BinaryDataLog logger;
+    if (!logger.LoadLogFile(log_file_name) || !logger.StartPrefetching()) {
+        ReportError("Test failed: load log file and start prefetching.");
+        return;
+    }
+    std::vector<const PackageDataPerTick *> ticks;
+    for (const auto &[package_id, package_data]: logger.packages_id_with_data()) {
+        if (logger.packages_id_with_objects().at(package_id)->size == 0) {
+            for (const auto &timestamped_data: package_data) {
+                ticks.emplace_back(&timestamped_data);
+            }
+        }
+    }
+
+    // Play forward and backward from a tick, payloads in time window should be found in payload cache.
+    const auto &time_range = logger.timestamp_s_range_of_loaded_log();
+    if (ticks.empty()) {
+        ReportError("Test failed: no package with dynamic size.");
+        return;
+    }
+    const float playback_time_s = ticks[ticks.size() / 2]->timestamp_s;
+    for (const bool is_playing_forward: {true, false}) {
+        logger.payload_cache().Clear();
+        logger.UpdatePlaybackTime(playback_time_s, is_playing_forward);
+        logger.WaitForPrefetching();
+        uint32_t num_of_ticks_in_window = 0;
+        for (const auto tick: ticks) {
+            const float time_diff_s = is_playing_forward ? tick->timestamp_s - playback_time_s : playback_time_s - tick->timestamp_s;
+            if (time_diff_s >= 0.0f && time_diff_s <= logger.prefetch_window_s()) {
+                ++num_of_ticks_in_window;
+                const BinaryDataView view = logger.LoadBinaryDataViewFromLogFile(tick->index_in_file, tick->size_of_all_in_file);
+                if (view.size() != tick->size_of_all_in_file || !std::equal(tick->data.begin(), tick->data.end(), view.begin() + 4 + 2 + 4)) {
+                    ReportError("Test failed: prefetched payload is different from loaded log file.");
+                    return;
+                }
+            }
+        }
+        const auto statistics = logger.payload_cache().statistics();
+        if (num_of_ticks_in_window == 0 || statistics.num_of_hits != num_of_ticks_in_window || statistics.num_of_misses != 0) {
+            ReportError("Test failed: payloads in time window are not prefetched, playing forward " << is_playing_forward << ".");
+            return;
+        }
+    }
+    logger.StopPrefetching();
+
+    // Size of prefetched payloads is limited by window size.
+    const uint64_t prefetch_window_size = 100000;
+    logger.payload_cache().Clear();
+    logger.prefetch_window_size() = prefetch_window_size;
+    logger.prefetch_window_s() = time_range.second - time_range.first;
+    if (!logger.StartPrefetching()) {
+        ReportError("Test failed: start prefetching.");
+        return;
+    }
+    logger.UpdatePlaybackTime(time_range.first);
+    logger.WaitForPrefetching();
+    const auto statistics = logger.payload_cache().statistics();
+    if (statistics.num_of_cached_items == 0 || statistics.size_of_cached_bytes > prefetch_window_size) {
+        ReportError("Test failed: size of prefetched payloads is out of window.");
+        return;
+    }
+
+    // Loading log file again while prefetching stops prefetcher, and refreshing followed log file only pauses it.
+    for (uint32_t i = 0; i < 5; ++i) {
+        logger.UpdatePlaybackTime(time_range.first + (time_range.second - time_range.first) * i / 5.0f);
+        if (!logger.LoadLogFile(log_file_name) || logger.IsPrefetching() || !logger.StartPrefetching()) {
+            ReportError("Test failed: load log file again while prefetching.");
+            return;
+        }
+    }
+    if (!logger.FollowLogFile(log_file_name) || logger.IsPrefetching() || !logger.StartPrefetching()) {
+        ReportError("Test failed: follow log file while prefetching.");
+        return;
+    }
+    for (uint32_t i = 0; i < 5; ++i) {
+        logger.UpdatePlaybackTime(time_range.first + (time_range.second - time_range.first) * i / 5.0f);
+        if (!logger.RefreshFollowedLogFile() || !logger.IsPrefetching()) {
+            ReportError("Test failed: refresh followed log file while prefetching.");
+            return;
+        }
+    }
+    // Payloads near the last playback time are prefetched again after refreshing, without updating playback time.
+    logger.WaitForPrefetching();
+    logger.payload_cache().Clear();
+    if (!logger.RefreshFollowedLogFile()) {
+        ReportError("Test failed: refresh followed log file while prefetching.");
+        return;
+    }
+    logger.WaitForPrefetching();
+    if (logger.payload_cache().statistics().num_of_cached_items == 0) {
+        ReportError("Test failed: payloads are not prefetched after refreshing followed log file.");
+        return;
+    }
+    logger.StopPrefetching();
+    ReportInfo("Payloads near playback time are prefetched.");
+}
+
+void TestReplayLogFile(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test replaying log file on recorded schedule." RESET_COLOR);
+
+    // Packages with dynamic size are not fully loaded, so replayer should load them from log file.
+    BinaryDataLog logger;
+    BinaryDataLog full_logger;
+    if (!logger.LoadLogFile(log_file_name) || !full_logger.LoadLogFile(log_file_name, true)) {
+        ReportError("Test failed: load log file.");
+        return;
+    }
+
+    // Replay all packages as fast as possible, ticks should be dispatched in timestamp order with the same binary data.
+    BinaryDataLogReplayer replayer(logger);
+    std::vector<PackageDataView> dispatched_views;
+    std::vector<std::vector<uint8_t>> dispatched_data;
+    for (const auto &pair: logger.packages_id_with_data()) {
+        replayer.SetCallback(pair.first, [&](const PackageDataView &package_data_view) {
+            dispatched_views.emplace_back(package_data_view);
+            dispatched_data.emplace_back(package_data_view.data, package_data_view.data + package_data_view.size_of_data);
+        });
+    }
+    replayer.as_fast_as_possible() = true;
+    if (!replayer.Start()) {
+        ReportError("Test failed: start replaying.");
+        return;
+    }
+    replayer.WaitUntilFinished();
+    uint64_t num_of_ticks = 0;
+    std::unordered_map<uint16_t, uint32_t> packages_id_with_index_of_tick;
+    for (uint64_t i = 0; i < dispatched_views.size(); ++i) {
+        const PackageDataView &view = dispatched_views[i];
+        if (i > 0 && view.timestamp_s < dispatched_views[i - 1].timestamp_s) {
+            ReportError("Test failed: ticks are not replayed in timestamp order.");
+            return;
+        }
+        const PackageDataPerTick &tick = full_logger.packages_id_with_data().at(view.package_id)[packages_id_with_index_of_tick[view.package_id]++];
+        if (view.timestamp_s != tick.timestamp_s || view.index_in_file != tick.index_in_file || dispatched_data[i] != tick.data) {
+            ReportError("Test failed: replayed package id " << view.package_id << " at " << view.timestamp_s << "s is different from loaded log file.");
+            return;
+        }
+    }
+    for (const auto &pair: logger.packages_id_with_data()) {
+        num_of_ticks += pair.second.size();
+    }
+    if (dispatched_views.size() != num_of_ticks || replayer.statistics().num_of_dispatched_ticks != num_of_ticks || replayer.IsReplaying()) {
+        ReportError("Test failed: replayed " << dispatched_views.size() << " ticks, but " << num_of_ticks << " ticks are loaded.");
+        return;
+    }
+    ReportInfo("Replay " << num_of_ticks << " ticks as fast as possible.");
+
+    // Typed callback of one package, replayed on schedule from a timestamp near the end.
+    const auto &time_range = logger.timestamp_s_range_of_loaded_log();
+    const auto &state_data_ticks = logger.packages_id_with_data().at(7);
+    BinaryDataLogReplayer typed_replayer(logger);
+    std::vector<std::pair<float, StateData>> replayed_state_data;
+    typed_replayer.SetCallback<StateData>(7, [&](const float timestamp_s, const StateData &state_data) {
+        replayed_state_data.emplace_back(timestamp_s, state_data);
+    });
+    typed_replayer.speed() = 10.0f;
+    const float start_timestamp_s = time_range.second - 2.0f;
+    const auto start_time = std::chrono::steady_clock::now();
+    typed_replayer.Start(start_timestamp_s);
+    typed_replayer.WaitUntilFinished();
+    const float elapsed_time_s = std::chrono::duration<float>(std::chrono::steady_clock::now() - start_time).count();
+    uint32_t num_of_expected_ticks = 0;
+    for (const auto &tick: state_data_ticks) {
+        CONTINUE_IF(tick.timestamp_s < start_timestamp_s);
+        StateData state_data;
+        std::memcpy(&state_data, tick.data.data(), sizeof(state_data));
+        if (num_of_expected_ticks >= replayed_state_data.size() || replayed_state_data[num_of_expected_ticks].first != tick.timestamp_s ||
+            std::memcmp(&replayed_state_data[num_of_expected_ticks].second, &state_data, sizeof(state_data)) != 0) {
+            ReportError("Test failed: typed callback is not called with recorded data.");
+            return;
+        }
+        ++num_of_expected_ticks;
+    }
+    const float expected_time_s = (state_data_ticks.back().timestamp_s - replayed_state_data.front().first) / typed_replayer.speed();
+    if (num_of_expected_ticks != replayed_state_data.size() || elapsed_time_s < expected_time_s * 0.9f || elapsed_time_s > expected_time_s + 0.1f) {
+        ReportError("Test failed: replay " << replayed_state_data.size() << " ticks in " << elapsed_time_s << "s, expected " << expected_time_s << "s.");
+        return;
+    }
+    ReportInfo("Replay " << num_of_expected_ticks << " ticks at speed " << typed_replayer.speed() << " in " << elapsed_time_s << "s, average delay "
+                         << typed_replayer.statistics().average_delay_us << "us.");
+
+    // Pause stops dispatching, and seeking replays from the new timestamp.
+    replayed_state_data.clear();
+    typed_replayer.speed() = 1.0f;
+    typed_replayer.Start();
+    typed_replayer.Pause();
+    const uint64_t num_of_dispatched_ticks = typed_replayer.statistics().num_of_dispatched_ticks;
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    if (!typed_replayer.is_paused() || typed_replayer.statistics().num_of_dispatched_ticks != num_of_dispatched_ticks) {
+        ReportError("Test failed: ticks are dispatched while pausing.");
+        return;
+    }
+    typed_replayer.as_fast_as_possible() = true;
+    typed_replayer.Seek(start_timestamp_s);
+    typed_replayer.Resume();
+    typed_replayer.WaitUntilFinished();
+    if (replayed_state_data.size() != num_of_dispatched_ticks + num_of_expected_ticks ||
+        replayed_state_data[num_of_dispatched_ticks].first != state_data_ticks[state_data_ticks.size() - num_of_expected_ticks].timestamp_s) {
+        ReportError("Test failed: replay after pausing and seeking.");
+        return;
+    }
+    ReportInfo("Pause and seek replaying.");
+}
+
+void TestLoadBinaryDataFromLogFile(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test loading binary data from mapped log file." RESET_COLOR);
+
+    BinaryDataLog logger;
+    if (!logger.LoadLogFile(log_file_name, true)) {
+        ReportError("Test failed: load log file.");
+        return;
+    }
+
+    // Data loaded by index should be the same as data loaded with log file.
+    for (const auto &[package_id, package_data]: logger.packages_id_with_data()) {
+        for (const auto &timestamped_data: package_data) {
+            const uint32_t data_size = timestamped_data.data.size();
+            uint8_t *data_ptr = logger.LoadBinaryDataFromLogFile(timestamped_data.index_in_file + 4 + 2 + 4, data_size);
+            const bool is_same = data_ptr != nullptr && std::equal(timestamped_data.data.begin(), timestamped_data.data.end(), data_ptr);
+            delete[] data_ptr;
+            if (!is_same) {
+                ReportError("Test failed: binary data of package " << package_id << " loaded by index is different.");
+                return;
+            }
+        }
+    }
+
+    // Binary data out of log file cannot be loaded.
+    const uint64_t file_size = logger.mapped_file_r().size();
+    uint8_t *data_ptr = logger.LoadBinaryDataFromLogFile(file_size - 4, 5);
+    if (data_ptr != nullptr) {
+        delete[] data_ptr;
+        ReportError("Test failed: binary data out of log file is loaded.");
+        return;
+    }
+    ReportInfo("Binary data loaded by index is the same as loaded log file.");
+}
+
+void TestMultiThreadRecordLog(const std::string &log_file_name, bool use_async_recorder) {
+    ReportInfo(YELLOW ">> Test recording binary data log by multiple threads." RESET_COLOR);
+    constexpr uint32_t kNumOfThreads = 8;
+    constexpr uint32_t kNumOfPackagesPerThread = 5000;
+
+    {
+        BinaryDataLog logger;
+        RETURN_IF(!logger.CreateLogFile(log_file_name));
+        // Each thread records its own package, and also shares one package with all other threads.
+        for (uint32_t i = 0; i <= kNumOfThreads; ++i) {
+            std::unique_ptr<PackageInfo> package_ptr = std::make_unique<PackageInfo>();
+            package_ptr->id = 100 + i;
+            package_ptr->name = "sequence " + std::to_string(i);
+            package_ptr->items.emplace_back(PackageItemInfo {.type = ItemType::kUint32, .name = "thread_index"});
+            package_ptr->items.emplace_back(PackageItemInfo {.type = ItemType::kUint32, .name = "sequence"});
+            package_ptr->items.emplace_back(PackageItemInfo {.type = ItemType::kFloat, .name = "value"});
+            RETURN_IF(!logger.RegisterPackage(package_ptr));
+        }
+        RETURN_IF(!logger.PrepareForRecording());
+        // Use a small ring buffer, so recorders will often wait for writer thread.
+        if (use_async_recorder) {
+            RETURN_IF(!logger.EnableAsyncRecording(4096));
+        }
+
+        std::vector<std::thread> threads;
+        for (uint32_t i = 0; i < kNumOfThreads; ++i) {
+            threads.emplace_back([&logger, i]() {
+                for (uint32_t j = 0; j < kNumOfPackagesPerThread; ++j) {
+                    const SequenceData data {.thread_index = i, .sequence = j, .value = static_cast<float>(i * j)};
+                    logger.RecordPackage(100 + i, reinterpret_cast<const char *>(&data), static_cast<float>(j) * 1e-3f);
+                    logger.RecordPackage(100 + kNumOfThreads, reinterpret_cast<const char *>(&data), static_cast<float>(j * kNumOfThreads + i) * 1e-4f);
+                }
+            });
+        }
+        for (auto &thread: threads) {
+            thread.join();
+        }
+    }
+
+    // Every frame should be decoded with correct summary check, and sequence of each thread should be kept.
+    BinaryDataLog logger;
+    if (!logger.LoadLogFile(log_file_name)) {
+        ReportError("Test failed: load log file recorded by multiple threads.");
+        return;
+    }
+    for (uint32_t i = 0; i <= kNumOfThreads; ++i) {
+        const auto it = logger.packages_id_with_data().find(100 + i);
+        const uint32_t expected_size = i < kNumOfThreads ? kNumOfPackagesPerThread : kNumOfPackagesPerThread * kNumOfThreads;
+        if (it == logger.packages_id_with_data().end() || it->second.size() != expected_size) {
+            ReportError("Test failed: package " << 100 + i << " lost frames.");
+            return;
+        }
+
+        std::vector<uint32_t> next_sequence_of_threads(kNumOfThreads, 0);
+        for (const auto &package_data_per_tick: it->second) {
+            const SequenceData *data = reinterpret_cast<const SequenceData *>(package_data_per_tick.data.data());
+            if (data->thread_index >= kNumOfThreads || (i < kNumOfThreads && data->thread_index != i)) {
+                ReportError("Test failed: package " << 100 + i << " has frame from wrong thread " << data->thread_index << ".");
+                return;
+            }
+            uint32_t &next_sequence = next_sequence_of_threads[data->thread_index];
+            if (data->sequence != next_sequence || data->value != static_cast<float>(data->thread_index * data->sequence)) {
+                ReportError("Test failed: package " << 100 + i << " frame of thread " << data->thread_index << " is out of order.");
+                return;
+            }
+            ++next_sequence;
+        }
+    }
+    ReportInfo("Frames of " << kNumOfThreads << " threads are all decoded in order.");
+
+    // Footer index should be recorded in the same order as frames in file.
+    BinaryDataLog indexed_logger;
+    if (!indexed_logger.LoadLogFileIndex(log_file_name) || !IsSameIndexOfLoadedLogs(logger, indexed_logger)) {
+        ReportError("Test failed: footer index of log file recorded by multiple threads is different from scanning.");
+    }
+}
+
+void TestCreateLogFileByCsvFile(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test creating log file by csv file." RESET_COLOR);
+
+    // Lines with wrong number of values or invalid values are skipped, and the first empty line ends the csv file.
+    const std::string csv_file_name = log_file_name.substr(0, log_file_name.find_last_of('.')) + ".csv";
+    {
+        std::ofstream csv_file(csv_file_name, std::ios::trunc);
+        csv_file << "timestamp_s, imu/gyro_x, imu/gyro_y, imu/gyro_z, imu/temperature, odom/velocity\r\n"
+                 << "0.0,1.5,-2.25,+3,  4 ,5e-1\r\n"
+                 << "0.5,1.0,2.0,3.0,4.0\r\n"
+                 << "1.0,1,,2,3,4,5\r\n"
+                 << "1.5,1,2,abc,4,5\r\n"
+                 << "2.0,0x10,1 .5,3,4,5\r\n"
+                 << "\n"
+                 << "3.0,9,9,9,9,9\n";
+    }
+    BinaryDataLog logger;
+    if (!BinaryDataLog::CreateLogFileByCsvFile(csv_file_name, log_file_name) || !logger.LoadLogFile(log_file_name)) {
+        ReportError("Test failed: create log file by csv file.");
+        return;
+    }
+
+    // Package id is the column index of its first item. Gyro is recorded as vector3 of float, and temperature with integer values is
+    // inferred as uint8.
+    const auto imu_bytes = [](const std::array<float, 3> &gyro, const uint8_t temperature) {
+        std::vector<uint8_t> bytes(sizeof(gyro) + 1, temperature);
+        std::memcpy(bytes.data(), gyro.data(), sizeof(gyro));
+        return bytes;
+    };
+    const auto float_bytes = [](const float value) {
+        std::vector<uint8_t> bytes(sizeof(value));
+        std::memcpy(bytes.data(), &value, sizeof(value));
+        return bytes;
+    };
+    const std::vector<float> timestamps_s = {0.0f, 1.0f, 2.0f};
+    const std::vector<std::pair<uint16_t, std::vector<std::vector<uint8_t>>>> packages_id_with_bytes = {
+        {1, {imu_bytes({1.5f, -2.25f, 3.0f}, 4), imu_bytes({1.0f, 2.0f, 3.0f}, 4), imu_bytes({16.0f, 1.5f, 3.0f}, 4)}},
+        {5, {float_bytes(0.5f), float_bytes(5.0f), float_bytes(5.0f)}},
+    };
+    for (const auto &[package_id, bytes_of_ticks]: packages_id_with_bytes) {
+        const auto it = logger.packages_id_with_data().find(package_id);
+        if (it == logger.packages_id_with_data().end() || it->second.size() != bytes_of_ticks.size()) {
+            ReportError("Test failed: ticks of package " << package_id << " are not created by csv file.");
+            return;
+        }
+        for (uint32_t i = 0; i < bytes_of_ticks.size(); ++i) {
+            const auto &tick = it->second[i];
+            if (tick.timestamp_s != timestamps_s[i] || tick.data != bytes_of_ticks[i]) {
+                ReportError("Test failed: tick " << i << " of package " << package_id << " is different from csv file.");
+                return;
+            }
+        }
+    }
+    ReportInfo("Log file created by csv file has the same values.");
+
+    // Each scalar column is recorded in the narrowest type which holds its values exactly, unless its type is forced.
+    {
+        std::ofstream csv_file(csv_file_name, std::ios::trunc);
+        csv_file << "timestamp_ms,state/flag,state/counter,state/offset,state/precise,state/ratio,state/forced\n";
+        for (int32_t i = 0; i < 2000; ++i) {
+            csv_file << i << "," << i % 2 << "," << i * 100 << "," << i - 1000 << "," << (i == 1500 ? "nan" : "1.234567891") << "," << i * 0.25 << ","
+                     << i % 3 << "\n";
+        }
+    }
+    BinaryDataLog typed_logger;
+    if (!BinaryDataLog::CreateLogFileByCsvFile(csv_file_name, log_file_name, 1, {{"state/forced", ItemType::kDouble}}) ||
+        !typed_logger.LoadLogFile(log_file_name) || typed_logger.packages_id_with_objects().count(1) == 0) {
+        ReportError("Test failed: create log file by csv file with inferred types.");
+        return;
+    }
+    const std::vector<ItemType> inferred_types = {ItemType::kUint8, ItemType::kUint32, ItemType::kInt16, ItemType::kDouble, ItemType::kFloat, ItemType::kDouble};
+    const auto &typed_items = typed_logger.packages_id_with_objects().at(1)->items;
+    if (typed_items.size() != inferred_types.size() || typed_logger.packages_id_with_data().at(1).size() != 2000) {
+        ReportError("Test failed: items of package are not inferred from csv file.");
+        return;
+    }
+    for (uint32_t i = 0; i < inferred_types.size(); ++i) {
+        if (typed_items[i].type != inferred_types[i]) {
+            ReportError("Test failed: type of item " << typed_items[i].name << " is not inferred as expected.");
+            return;
+        }
+    }
+    // Values of all lines are exact in inferred types.
+    const auto &last_tick_data = typed_logger.packages_id_with_data().at(1).back().data;
+    uint8_t flag = 0;
+    uint32_t counter = 0;
+    int16_t offset = 0;
+    double precise = 0.0;
+    float ratio = 0.0f;
+    double forced = 0.0;
+    std::memcpy(&flag, last_tick_data.data(), 1);
+    std::memcpy(&counter, last_tick_data.data() + 1, 4);
+    std::memcpy(&offset, last_tick_data.data() + 5, 2);
+    std::memcpy(&precise, last_tick_data.data() + 7, 8);
+    std::memcpy(&ratio, last_tick_data.data() + 15, 4);
+    std::memcpy(&forced, last_tick_data.data() + 19, 8);
+    if (last_tick_data.size() != 27 || flag != 1 || counter != 199900 || offset != 999 || precise != 1.234567891 || ratio != 499.75f ||
+        forced != 1999 % 3) {
+        ReportError("Test failed: values of inferred types are different from csv file.");
+        return;
+    }
+
+    // Types are inferred from all lines, so values which leave the range of the first lines are still exact. Conversion fails if any value
+    // is changed by forced type.
+    {
+        std::ofstream csv_file(csv_file_name, std::ios::trunc);
+        csv_file << "timestamp_s,state/counter,state/speed\n";
+        for (uint32_t i = 0; i < 5000; ++i) {
+            csv_file << i * 0.01 << "," << i * 40 << "," << (i < 1100 ? 0.0 : 0.5) << "\n";
+        }
+    }
+    BinaryDataLog ranged_logger;
+    if (!BinaryDataLog::CreateLogFileByCsvFile(csv_file_name, log_file_name, 4) || !ranged_logger.LoadLogFile(log_file_name) ||
+        ranged_logger.packages_id_with_objects().at(1)->items[0].type != ItemType::kUint32 ||
+        ranged_logger.packages_id_with_objects().at(1)->items[1].type != ItemType::kFloat || ranged_logger.packages_id_with_data().at(1).size() != 5000) {
+        ReportError("Test failed: types are not inferred from all lines of csv file.");
+        return;
+    }
+    for (uint32_t i = 0; i < 5000; ++i) {
+        const auto &tick_data = ranged_logger.packages_id_with_data().at(1)[i].data;
+        uint32_t counter = 0;
+        float speed = 0.0f;
+        std::memcpy(&counter, tick_data.data(), 4);
+        std::memcpy(&speed, tick_data.data() + 4, 4);
+        if (counter != i * 40 || speed != (i < 1100 ? 0.0f : 0.5f)) {
+            ReportError("Test failed: value of line " << i << " is changed by inferred types.");
+            return;
+        }
+    }
+    if (BinaryDataLog::CreateLogFileByCsvFile(csv_file_name, log_file_name, 1, {{"state/speed", ItemType::kUint8}})) {
+        ReportError("Test failed: values changed by forced types are not reported.");
+        return;
+    }
+    ReportInfo("Log file created by csv file records columns in inferred types.");
+
+    // Csv file with multiple chunks should be converted into the same log file by multiple threads. Lines after the empty line are not
+    // used to infer types, even if they are scanned by another thread.
+    {
+        std::ofstream csv_file(csv_file_name, std::ios::trunc);
+        csv_file << "timestamp[ms],imu/gyro_x,imu/gyro_y,imu/gyro_z,odom/velocity\n";
+        for (uint32_t i = 0; i < 200000; ++i) {
+            if (i == 180000) {
+                csv_file << "\n";
+            } else if (i % 10007 == 0) {
+                csv_file << i << ",invalid,line\n";
+            } else {
+                csv_file << i * 5 << "," << std::sin(i * 0.01) << "," << std::cos(i * 0.01) << "," << i * 1e-3 << "," << (i > 180000 ? 1000 : i % 17) << "\n";
+            }
+        }
+    }
+    const auto read_log_file = [](const std::string &file_name) {
+        std::ifstream file(file_name, std::ios::binary);
+        return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    };
+    const std::string multi_thread_log_file_name = log_file_name + ".multi_thread";
+    if (!BinaryDataLog::CreateLogFileByCsvFile(csv_file_name, log_file_name) ||
+        !BinaryDataLog::CreateLogFileByCsvFile(csv_file_name, multi_thread_log_file_name, 4)) {
+        ReportError("Test failed: create log file by csv file with multiple threads.");
+        return;
+    }
+    BinaryDataLog multi_thread_logger;
+    if (read_log_file(log_file_name) != read_log_file(multi_thread_log_file_name) || !multi_thread_logger.LoadLogFile(multi_thread_log_file_name) ||
+        multi_thread_logger.packages_id_with_data().at(1).size() != 180000 - 18 ||
+        multi_thread_logger.packages_id_with_objects().at(4)->items[0].type != ItemType::kUint8) {
+        ReportError("Test failed: log file created by multiple threads is different.");
+        return;
+    }
+    ReportInfo("Log file created by csv file with multiple threads is the same.");
+
+    // Csv from stream or pipe should be recorded as the same frames. Csv is written into pipe in small pieces, so lines are split across reads.
+    const std::string stream_log_file_name = log_file_name + ".stream";
+    const std::string pipe_log_file_name = log_file_name + ".pipe";
+    std::ifstream csv_stream(csv_file_name, std::ios::binary);
+    int32_t pipe_file_descriptors[2] = {-1, -1};
+    const BinaryDataLog::CsvColumnTypes csv_column_types = {{"odom/velocity", ItemType::kUint8}};
+    if (!BinaryDataLog::CreateLogFileByCsvStream(csv_stream, stream_log_file_name, csv_column_types) || ::pipe(pipe_file_descriptors) != 0) {
+        ReportError("Test failed: create log file by csv stream.");
+        return;
+    }
+    std::thread writer_thread([&]() {
+        const std::vector<char> csv_bytes = read_log_file(csv_file_name);
+        for (uint64_t i = 0; i < csv_bytes.size();) {
+            const int64_t size_of_written = ::write(pipe_file_descriptors[1], csv_bytes.data() + i, std::min<uint64_t>(4099, csv_bytes.size() - i));
+            BREAK_IF(size_of_written <= 0);
+            i += size_of_written;
+        }
+        ::close(pipe_file_descriptors[1]);
+    });
+    const bool is_pipe_converted = BinaryDataLog::CreateLogFileByCsvFileDescriptor(pipe_file_descriptors[0], pipe_log_file_name, csv_column_types);
+    // Lines after the empty line are not read, so drain them before writer thread is joined.
+    std::array<char, 4096> drained_bytes;
+    while (::read(pipe_file_descriptors[0], drained_bytes.data(), drained_bytes.size()) > 0) {
+    }
+    writer_thread.join();
+    ::close(pipe_file_descriptors[0]);
+
+    BinaryDataLog file_logger;
+    BinaryDataLog stream_logger;
+    BinaryDataLog pipe_logger;
+    if (!is_pipe_converted || !file_logger.LoadLogFile(log_file_name) || !stream_logger.LoadLogFile(stream_log_file_name) ||
+        !pipe_logger.LoadLogFile(pipe_log_file_name) || !IsSameDataOfLoadedLogs(file_logger, stream_logger) ||
+        !IsSameDataOfLoadedLogs(file_logger, pipe_logger)) {
+        ReportError("Test failed: log file created by csv stream or pipe is different.");
+        return;
+    }
+
+    // Lines after buffer are not seen when types are inferred, so integer column of stream is recorded in double unless its type is forced.
+    std::ifstream unforced_csv_stream(csv_file_name, std::ios::binary);
+    BinaryDataLog unforced_stream_logger;
+    if (!BinaryDataLog::CreateLogFileByCsvStream(unforced_csv_stream, stream_log_file_name) || !unforced_stream_logger.LoadLogFile(stream_log_file_name) ||
+        unforced_stream_logger.packages_id_with_objects().at(4)->items[0].type != ItemType::kDouble ||
+        file_logger.packages_id_with_objects().at(4)->items[0].type != ItemType::kUint8) {
+        ReportError("Test failed: integer type is inferred from part of csv stream.");
+        return;
+    }
+
+    // Value after buffer which loses precision in float is still exact in stream, and conversion fails if float is forced.
+    std::string precise_csv = "timestamp_s,state/value\n";
+    for (uint32_t i = 0; precise_csv.size() < 3 * 1024 * 1024; ++i) {
+        precise_csv += std::to_string(i) + ",0.5\n";
+    }
+    precise_csv += "1e9,0.123456789\n";
+    std::istringstream precise_csv_stream(precise_csv);
+    BinaryDataLog precise_stream_logger;
+    if (!BinaryDataLog::CreateLogFileByCsvStream(precise_csv_stream, stream_log_file_name) || !precise_stream_logger.LoadLogFile(stream_log_file_name) ||
+        precise_stream_logger.packages_id_with_objects().at(1)->items[0].type != ItemType::kDouble) {
+        ReportError("Test failed: create log file by csv stream with precise value.");
+        return;
+    }
+    double precise_value = 0.0;
+    std::memcpy(&precise_value, precise_stream_logger.packages_id_with_data().at(1).back().data.data(), sizeof(precise_value));
+    std::istringstream forced_csv_stream(precise_csv);
+    if (precise_value != 0.123456789 ||
+        BinaryDataLog::CreateLogFileByCsvStream(forced_csv_stream, stream_log_file_name, {{"state/value", ItemType::kFloat}})) {
+        ReportError("Test failed: precise value after buffer of csv stream is changed by float.");
+        return;
+    }
+    ReportInfo("Log file created by csv stream or pipe is the same.");
+}
+
+void TestCreateLogFileByCsvFiles(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Test creating log file by merging csv files." RESET_COLOR);
+
+    // Timestamps of csv files are in different units, and lines of them are interleaved in time.
+    const std::string log_file_stem = log_file_name.substr(0, log_file_name.find_last_of('.'));
+    const std::vector<std::string> csv_file_names = {log_file_stem + "_imu.csv", log_file_stem + "_odom.csv"};
+    {
+        std::ofstream imu_csv_file(csv_file_names[0], std::ios::trunc);
+        imu_csv_file << "timestamp_s,imu/gyro_x,imu/gyro_y\n";
+        for (uint32_t i = 0; i < 10000; ++i) {
+            imu_csv_file << 1.0 + i * 0.002 << "," << i << "," << -static_cast<int32_t>(i) << "\n";
+        }
+        std::ofstream odom_csv_file(csv_file_names[1], std::ios::trunc);
+        odom_csv_file << "timestamp[ms],velocity\n";
+        for (uint32_t i = 0; i < 8000; ++i) {
+            odom_csv_file << 900 + i * 3 << "," << i * 0.5 << "\n";
+        }
+    }
+    BinaryDataLog logger;
+    if (!BinaryDataLog::CreateLogFileByCsvFiles(csv_file_names, log_file_name) || !logger.LoadLogFile(log_file_name)) {
+        ReportError("Test failed: create log file by merging csv files.");
+        return;
+    }
+
+    // Package ids of the second csv file follow columns of the first one, and its package without name is named by csv file.
+    const auto imu_it = logger.packages_id_with_data().find(1);
+    const auto odom_it = logger.packages_id_with_data().find(3 + 1);
+    if (imu_it == logger.packages_id_with_data().end() || odom_it == logger.packages_id_with_data().end() || imu_it->second.size() != 10000 ||
+        odom_it->second.size() != 8000 || logger.packages_id_with_objects().at(4)->name != "data_merged_odom") {
+        ReportError("Test failed: packages of merged csv files are not registered.");
+        return;
+    }
+
+    // The earliest timestamp of all csv files is the offset, and frames are recorded in order of timestamp.
+    if (odom_it->second.front().timestamp_s != 0.0f || std::fabs(imu_it->second.front().timestamp_s - 0.1f) > 1e-5f ||
+        std::fabs(odom_it->second.back().timestamp_s - 23.997f) > 1e-4f) {
+        ReportError("Test failed: timestamps of merged csv files are not offset by the earliest one.");
+        return;
+    }
+    std::vector<std::pair<uint64_t, float>> indices_in_file_with_timestamps_s;
+    for (const auto &[package_id, package_data]: logger.packages_id_with_data()) {
+        for (const auto &timestamped_data: package_data) {
+            indices_in_file_with_timestamps_s.emplace_back(timestamped_data.index_in_file, timestamped_data.timestamp_s);
+        }
+    }
+    std::sort(indices_in_file_with_timestamps_s.begin(), indices_in_file_with_timestamps_s.end());
+    for (uint32_t i = 1; i < indices_in_file_with_timestamps_s.size(); ++i) {
+        if (indices_in_file_with_timestamps_s[i].second < indices_in_file_with_timestamps_s[i - 1].second) {
+            ReportError("Test failed: frames of merged csv files are not ordered by timestamp.");
+            return;
+        }
+    }
+    ReportInfo("Log file created by merging csv files is ordered by timestamp.");
+}
+
 int main(int argc, char **argv) {
     ReportInfo(YELLOW ">> Test binary data log decodec." RESET_COLOR);
 
@@ -345,6 +2063,46 @@ int main(int argc, char **argv) {
     TestCreateLog(log_file_name);
     TestLoadLog(log_file_name);
     TestPreloadLog(log_file_name);
+    TestLoadLogIndex(log_file_name);
+    TestLoadBrokenDynamicPackage(log_file_name);
+    TestSidecarIndex(log_file_name);
+    TestLoadBinaryDataFromLogFile(log_file_name);
+    TestLoadBinaryDataViewFromLogFile(log_file_name);
+    TestLoadBinaryDataViewsInParallel(log_file_name);
+    TestPrefetchPayloads(log_file_name);
+    TestReplayLogFile(log_file_name);
+    TestLoadLogInParallel(log_file_name);
+    TestLoadLogInColumns(log_file_name);
+    TestQueryTicksInTimeRange(log_file_name);
+    TestQueryItemBuckets(log_file_name);
+    TestLoadSelectedPackages(log_file_name);
+    TestVisitLogFile(log_file_name);
+    TestFollowLogFile(log_file_name, "../../Binary_Data_Viewer/examples/data_followed.binlog");
+    TestFollowOutOfOrderTicks("../../Binary_Data_Viewer/examples/data_followed.binlog");
+
+    const std::string async_log_file_name = "../../Binary_Data_Viewer/examples/data_async.binlog";
+    TestCreateLog(async_log_file_name, true);
+    TestCompareLogFiles(log_file_name, async_log_file_name);
+
+    const std::string crc32c_log_file_name = "../../Binary_Data_Viewer/examples/data_crc32c.binlog";
+    TestCreateLog(crc32c_log_file_name, true, FrameCheckType::kCrc32c);
+    TestCompareLoadedLogs(log_file_name, crc32c_log_file_name);
+
+    const std::string multi_thread_log_file_name = "../../Binary_Data_Viewer/examples/data_multi_thread.binlog";
+    TestMultiThreadRecordLog(multi_thread_log_file_name, false);
+    TestMultiThreadRecordLog(multi_thread_log_file_name, true);
+    TestLoadLogInParallel(multi_thread_log_file_name);
+    TestLoadLogInColumns(multi_thread_log_file_name);
+    TestQueryTicksInTimeRange(multi_thread_log_file_name);
+    TestVisitLogFile(multi_thread_log_file_name);
+    TestFollowLogFile(multi_thread_log_file_name, "../../Binary_Data_Viewer/examples/data_followed.binlog");
+
+    const std::string all_types_log_file_name = "../../Binary_Data_Viewer/examples/data_all_types.binlog";
+    TestExtractItemColumns(all_types_log_file_name);
+    TestDecodeColumns(all_types_log_file_name);
+
+    TestCreateLogFileByCsvFile("../../Binary_Data_Viewer/examples/data_csv.binlog");
+    TestCreateLogFileByCsvFiles("../../Binary_Data_Viewer/examples/data_merged.binlog");
 
     return 0;
 }
@@ -0,0 +1,613 @@
+#include "binary_data_log.h"
+#include "binary_data_log_replayer.h"
+#include "slam_log_reporter.h"
+#include "slam_operations.h"
+
+#include "algorithm"
+#include "chrono"
+#include "cmath"
+#include "fstream"
+#include "iostream"
+#include "iterator"
+#include "thread"
+#include "vector"
+
+using namespace slam_data_log;
+
+#include "enable_stack_backward.h"
+
+#pragma pack(1)
+
+struct ImuData {
+    float gyro_x = 0.0f;
+    float gyro_y = 0.0f;
+    float gyro_z = 0.0f;
+    float accel_x = 0.0f;
+    float accel_y = 0.0f;
+    float accel_z = 0.0f;
+    uint8_t valid = 0;
+};
+
+#pragma pack()
+
+template <typename Func>
+double MeasureAverageTimeInMicrosecond(const uint32_t times, Func &&func) {
+    const auto begin_time = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < times; ++i) {
+        func(i);
+    }
+    const auto end_time = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end_time - begin_time).count() / static_cast<double>(times);
+}
+
+void RegisterBenchmarkPackages(BinaryDataLog &logger) {
+    {
+        std::unique_ptr<PackageInfo> package_ptr = std::make_unique<PackageInfo>();
+        package_ptr->id = 1;
+        package_ptr->name = "imu";
+        package_ptr->items.emplace_back(PackageItemInfo {.type = ItemType::kVector3, .name = "gyro"});
+        package_ptr->items.emplace_back(PackageItemInfo {.type = ItemType::kVector3, .name = "accel"});
+        package_ptr->items.emplace_back(PackageItemInfo {.type = ItemType::kUint8, .name = "valid"});
+        logger.RegisterPackage(package_ptr);
+    }
+    {
+        std::unique_ptr<PackageInfo> package_ptr = std::make_unique<PackageInfo>();
+        package_ptr->id = 2;
+        package_ptr->name = "point cloud";
+        package_ptr->items.emplace_back(PackageItemInfo {.type = ItemType::kPointCloud, .name = "point cloud"});
+        logger.RegisterPackage(package_ptr);
+    }
+    {
+        std::unique_ptr<PackageInfo> package_ptr = std::make_unique<PackageInfo>();
+        package_ptr->id = 3;
+        package_ptr->name = "line cloud";
+        package_ptr->items.emplace_back(PackageItemInfo {.type = ItemType::kLineCloud, .name = "line cloud"});
+        logger.RegisterPackage(package_ptr);
+    }
+}
+
+void BenchmarkRecordPackages(const std::string &log_file_name, FrameCheckType frame_check_type) {
+    ReportInfo(YELLOW ">> Benchmark recording packages, frame check type " << static_cast<int32_t>(frame_check_type) << "." RESET_COLOR);
+
+    BinaryDataLog logger;
+    RETURN_IF(!logger.CreateLogFile(log_file_name, frame_check_type));
+    RegisterBenchmarkPackages(logger);
+    RETURN_IF(!logger.PrepareForRecording());
+
+    constexpr uint32_t kNumOfStaticPackages = 1000000;
+    ImuData imu_data;
+    const double static_package_time = MeasureAverageTimeInMicrosecond(kNumOfStaticPackages, [&](uint32_t i) {
+        imu_data.gyro_x = static_cast<float>(i);
+        logger.RecordPackage(1, reinterpret_cast<const char *>(&imu_data), static_cast<float>(i) * 1e-3f);
+    });
+    ReportInfo("Record static package of " << sizeof(ImuData) << " bytes : " << static_package_time << " us per frame.");
+
+    constexpr uint32_t kNumOfPoints = 100000;
+    constexpr uint32_t kNumOfPointClouds = 100;
+    std::vector<Vec3> points_cloud;
+    for (uint32_t i = 0; i < kNumOfPoints; ++i) {
+        points_cloud.emplace_back(Vec3(i, 0.5f * i, 0.25f * i));
+    }
+    const double point_cloud_time = MeasureAverageTimeInMicrosecond(
+        kNumOfPointClouds, [&](uint32_t i) { logger.RecordPackage(2, points_cloud, static_cast<float>(i)); });
+    ReportInfo("Record point cloud of " << kNumOfPoints << " points : " << point_cloud_time << " us per frame.");
+
+    constexpr uint32_t kNumOfLines = 50000;
+    constexpr uint32_t kNumOfLineClouds = 100;
+    std::vector<std::pair<Vec3, Vec3>> line_cloud;
+    for (uint32_t i = 0; i < kNumOfLines; ++i) {
+        line_cloud.emplace_back(std::make_pair(Vec3(i, 0.5f * i, 0.25f * i), Vec3(0.25f * i, 0.5f * i, i)));
+    }
+    const double line_cloud_time = MeasureAverageTimeInMicrosecond(
+        kNumOfLineClouds, [&](uint32_t i) { logger.RecordPackage(3, line_cloud, static_cast<float>(i)); });
+    ReportInfo("Record line cloud of " << kNumOfLines << " lines : " << line_cloud_time << " us per frame.");
+}
+
+void BenchmarkLoadLogFile(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Benchmark loading log file." RESET_COLOR);
+
+    // Log file is scanned for each loading here.
+    constexpr uint32_t kNumOfLoadTimes = 5;
+    uint64_t num_of_ticks = 0;
+    const double load_time = MeasureAverageTimeInMicrosecond(kNumOfLoadTimes, [&](uint32_t i) {
+        BinaryDataLog logger;
+        logger.use_sidecar_index() = false;
+        logger.LoadLogFile(log_file_name, true);
+        num_of_ticks = 0;
+        for (const auto &pair: logger.packages_id_with_data()) {
+            num_of_ticks += pair.second.size();
+        }
+    });
+    ReportInfo("Load log file of " << num_of_ticks << " ticks with full data : " << load_time * 1e-3 << " ms.");
+
+    const double preload_time = MeasureAverageTimeInMicrosecond(kNumOfLoadTimes, [&](uint32_t i) {
+        BinaryDataLog logger;
+        logger.use_sidecar_index() = false;
+        logger.LoadLogFile(log_file_name, false);
+    });
+    ReportInfo("Load log file without dynamic package data : " << preload_time * 1e-3 << " ms.");
+
+    const double columns_load_time = MeasureAverageTimeInMicrosecond(kNumOfLoadTimes, [&](uint32_t i) {
+        BinaryDataLog logger;
+        logger.use_sidecar_index() = false;
+        logger.load_static_package_in_columns() = true;
+        logger.LoadLogFile(log_file_name, true);
+    });
+    ReportInfo("Load log file with full data, packages with static size in columns : " << columns_load_time * 1e-3 << " ms.");
+
+    const uint32_t num_of_threads = std::max(2u, std::thread::hardware_concurrency());
+    const double parallel_load_time = MeasureAverageTimeInMicrosecond(kNumOfLoadTimes, [&](uint32_t i) {
+        BinaryDataLog logger;
+        logger.use_sidecar_index() = false;
+        logger.num_of_threads_for_loading() = num_of_threads;
+        logger.LoadLogFile(log_file_name, true);
+    });
+    ReportInfo("Load log file with full data by " << num_of_threads << " threads : " << parallel_load_time * 1e-3 << " ms.");
+
+    uint64_t num_of_visited_frames = 0;
+    const double visit_time = MeasureAverageTimeInMicrosecond(kNumOfLoadTimes, [&](uint32_t i) {
+        BinaryDataLog logger;
+        logger.use_sidecar_index() = false;
+        num_of_visited_frames = 0;
+        logger.VisitLogFile(log_file_name, [&](const PackageDataView &package_data_view) {
+            ++num_of_visited_frames;
+            return true;
+        });
+    });
+    ReportInfo("Visit log file of " << num_of_visited_frames << " frames one by one : " << visit_time * 1e-3 << " ms.");
+
+    for (const uint16_t package_id: {1, 2}) {
+        const double selected_load_time = MeasureAverageTimeInMicrosecond(kNumOfLoadTimes, [&](uint32_t i) {
+            BinaryDataLog logger;
+        logger.use_sidecar_index() = false;
+            logger.package_ids_to_load() = {package_id};
+            logger.LoadLogFile(log_file_name, true);
+        });
+        ReportInfo("Load log file with full data of package " << package_id << " only : " << selected_load_time * 1e-3 << " ms.");
+    }
+
+    // Load data of dynamic packages by index.
+    BinaryDataLog logger;
+    RETURN_IF(!logger.LoadLogFile(log_file_name, false));
+    std::vector<PackageDataPerTick> ticks;
+    for (const auto &pair: logger.packages_id_with_data()) {
+        if (pair.first != 1) {
+            ticks.insert(ticks.end(), pair.second.begin(), pair.second.end());
+        }
+    }
+    RETURN_IF(ticks.empty());
+    const double load_data_time = MeasureAverageTimeInMicrosecond(ticks.size(), [&](uint32_t i) {
+        uint8_t *data_ptr = logger.LoadBinaryDataFromLogFile(ticks[i].index_in_file, ticks[i].size_of_all_in_file);
+        delete[] data_ptr;
+    });
+    ReportInfo("Load binary data of dynamic package by index : " << load_data_time << " us per frame.");
+
+    // Scrubbing views the same frames again and again. The first time of viewing copies them into payload cache.
+    constexpr uint32_t kNumOfScrubbingTimes = 10;
+    const double load_view_first_time = MeasureAverageTimeInMicrosecond(ticks.size(), [&](uint32_t i) {
+        const BinaryDataView view = logger.LoadBinaryDataViewFromLogFile(ticks[i].index_in_file, ticks[i].size_of_all_in_file);
+    });
+    const double load_view_time = MeasureAverageTimeInMicrosecond(ticks.size() * kNumOfScrubbingTimes, [&](uint32_t i) {
+        const auto &tick = ticks[i % ticks.size()];
+        const BinaryDataView view = logger.LoadBinaryDataViewFromLogFile(tick.index_in_file, tick.size_of_all_in_file);
+    });
+    const auto statistics = logger.payload_cache().statistics();
+    ReportInfo("Load binary data view of dynamic package by index : " << load_view_first_time << " us per frame at first time, then "
+                                                                       << load_view_time << " us per frame, "
+                                                                    << statistics.num_of_hits << " hits, " << statistics.num_of_misses << " misses, "
+                                                                    << statistics.size_of_cached_bytes << " bytes cached.");
+}
+
+void BenchmarkSidecarIndex(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Benchmark reopening log file by sidecar index." RESET_COLOR);
+
+    // Footer index is removed, as a log file which is truncated or not recorded with footer index.
+    std::ifstream log_file(log_file_name, std::ios::binary);
+    std::vector<char> log_file_bytes((std::istreambuf_iterator<char>(log_file)), std::istreambuf_iterator<char>());
+    BinaryDataLog footer_logger;
+    RETURN_IF(!footer_logger.LoadLogFile(log_file_name));
+    uint64_t size_without_footer = 0;
+    for (const auto &pair: footer_logger.packages_id_with_data()) {
+        for (const auto &tick: pair.second) {
+            size_without_footer = std::max(size_without_footer, tick.index_in_file + tick.size_of_all_in_file);
+        }
+    }
+    const std::string truncated_log_file_name = log_file_name + ".truncated";
+    std::ofstream truncated_log_file(truncated_log_file_name, std::ios::binary | std::ios::trunc);
+    truncated_log_file.write(log_file_bytes.data(), size_without_footer);
+    truncated_log_file.close();
+
+    const std::vector<std::string> ways_of_loading = {"LoadLogFile with full data", "LoadLogFile with full data in columns", "LoadLogFileIndex"};
+    for (uint32_t way = 0; way < ways_of_loading.size(); ++way) {
+        std::remove((truncated_log_file_name + ".idx").c_str());
+        const auto load_log_file = [&](BinaryDataLog &logger) {
+            logger.load_static_package_in_columns() = way == 1;
+            return way == 2 ? logger.LoadLogFileIndex(truncated_log_file_name) : logger.LoadLogFile(truncated_log_file_name, true);
+        };
+        const double scan_time = MeasureAverageTimeInMicrosecond(1, [&](uint32_t i) {
+            BinaryDataLog logger;
+            logger.use_sidecar_index() = false;
+            load_log_file(logger);
+        });
+        const double first_open_time = MeasureAverageTimeInMicrosecond(1, [&](uint32_t i) {
+            BinaryDataLog logger;
+            load_log_file(logger);
+        });
+        const double reopen_time = MeasureAverageTimeInMicrosecond(5, [&](uint32_t i) {
+            BinaryDataLog logger;
+            load_log_file(logger);
+        });
+        ReportInfo(ways_of_loading[way] << " : scan " << scan_time * 1e-3 << " ms, first open with saving " << first_open_time * 1e-3 << " ms, reopen "
+                                        << reopen_time * 1e-3 << " ms.");
+    }
+    std::remove(truncated_log_file_name.c_str());
+    std::remove((truncated_log_file_name + ".idx").c_str());
+}
+
+void BenchmarkLoadBinaryDataViewsInParallel(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Benchmark loading binary data views by multiple threads." RESET_COLOR);
+
+    BinaryDataLog logger;
+    RETURN_IF(!logger.LoadLogFile(log_file_name, false));
+    std::vector<std::pair<uint64_t, uint32_t>> requests;
+    for (const auto &pair: logger.packages_id_with_data()) {
+        if (pair.first != 1) {
+            for (const auto &tick: pair.second) {
+                requests.emplace_back(tick.index_in_file, tick.size_of_all_in_file);
+            }
+        }
+    }
+
+    // Payload cache is disabled, so each request is copied from log file.
+    logger.payload_cache().SetSizeBudget(0);
+    constexpr uint32_t kNumOfLoadTimes = 5;
+    double single_thread_time = 0.0;
+    for (const uint32_t num_of_threads: {1, 2, 4, 8}) {
+        logger.num_of_threads_for_loading() = num_of_threads;
+        std::vector<BinaryDataView> views;
+        const double load_time = MeasureAverageTimeInMicrosecond(kNumOfLoadTimes, [&](uint32_t i) { logger.LoadBinaryDataViewsFromLogFile(requests, views); });
+        single_thread_time = num_of_threads == 1 ? load_time : single_thread_time;
+        ReportInfo("Load " << requests.size() << " binary data views by " << num_of_threads << " threads : " << load_time * 1e-3 << " ms, speedup "
+                           << single_thread_time / load_time << ".");
+    }
+}
+
+void BenchmarkPrefetchPayloads(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Benchmark prefetching payloads for playback." RESET_COLOR);
+
+    for (const bool enable_prefetcher: {false, true}) {
+        BinaryDataLog logger;
+        RETURN_IF(!logger.LoadLogFile(log_file_name, false));
+        if (enable_prefetcher) {
+            RETURN_IF(!logger.StartPrefetching());
+        }
+
+        // Play point clouds and line clouds forward, each step is 0.1s and costs 2ms for rendering.
+        constexpr float kTimeOfStepS = 0.1f;
+        constexpr uint32_t kNumOfSteps = 1000;
+        double fetch_time = 0.0;
+        for (uint32_t i = 0; i < kNumOfSteps; ++i) {
+            const float playback_time_s = static_cast<float>(i) * kTimeOfStepS;
+            logger.UpdatePlaybackTime(playback_time_s);
+            for (const uint16_t package_id: {2, 3}) {
+                uint32_t index_of_begin_tick = 0;
+                uint32_t index_of_end_tick = 0;
+                logger.Query(package_id, playback_time_s, playback_time_s + kTimeOfStepS * 0.99f, index_of_begin_tick, index_of_end_tick);
+                for (uint32_t j = index_of_begin_tick; j < index_of_end_tick; ++j) {
+                    const auto &tick = logger.packages_id_with_data().at(package_id)[j];
+                    fetch_time += MeasureAverageTimeInMicrosecond(
+                        1, [&](uint32_t k) { const BinaryDataView view = logger.LoadBinaryDataViewFromLogFile(tick.index_in_file, tick.size_of_all_in_file); });
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        const auto statistics = logger.payload_cache().statistics();
+        ReportInfo("Play " << kNumOfSteps << " steps " << (enable_prefetcher ? "with" : "without") << " prefetcher : fetch " << fetch_time * 1e-3
+                           << " ms in foreground, " << statistics.num_of_hits << " hits, " << statistics.num_of_misses << " misses.");
+    }
+}
+
+void BenchmarkReplayLogFile(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Benchmark replaying log file." RESET_COLOR);
+
+    BinaryDataLog logger;
+    RETURN_IF(!logger.LoadLogFile(log_file_name, false));
+
+    // Replay all packages as fast as possible.
+    {
+        BinaryDataLogReplayer replayer(logger);
+        uint64_t size_of_dispatched_data = 0;
+        for (const uint16_t package_id: {1, 2, 3}) {
+            replayer.SetCallback(package_id, [&](const PackageDataView &package_data_view) { size_of_dispatched_data += package_data_view.size_of_data; });
+        }
+        replayer.as_fast_as_possible() = true;
+        const double replay_time = MeasureAverageTimeInMicrosecond(1, [&](uint32_t i) {
+            replayer.Start();
+            replayer.WaitUntilFinished();
+        });
+        ReportInfo("Replay " << replayer.statistics().num_of_dispatched_ticks << " ticks (" << size_of_dispatched_data / 1024 / 1024
+                             << " MB) as fast as possible : " << replay_time * 1e-3 << " ms.");
+    }
+
+    // Replay point clouds and line clouds at a high rate, which are loaded from log file before dispatching.
+    for (const uint32_t size_of_decoded_queue: {1, 64}) {
+        BinaryDataLogReplayer replayer(logger);
+        for (const uint16_t package_id: {2, 3}) {
+            replayer.SetCallback(package_id, [](const PackageDataView &package_data_view) {});
+        }
+        replayer.speed() = 200.0f;
+        replayer.size_of_decoded_queue() = size_of_decoded_queue;
+        logger.payload_cache().Clear();
+        const double replay_time = MeasureAverageTimeInMicrosecond(1, [&](uint32_t i) {
+            replayer.Start();
+            replayer.WaitUntilFinished();
+        });
+        const auto statistics = replayer.statistics();
+        ReportInfo("Replay " << statistics.num_of_dispatched_ticks << " ticks at speed " << replayer.speed() << " with decoded queue of size "
+                             << size_of_decoded_queue << " : " << replay_time * 1e-3 << " ms, average delay " << statistics.average_delay_us
+                             << " us, max delay " << statistics.max_delay_us << " us.");
+    }
+}
+
+void BenchmarkFollowLogFile(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Benchmark following log file." RESET_COLOR);
+
+    std::ifstream log_file(log_file_name, std::ios::binary);
+    const std::vector<char> log_file_bytes((std::istreambuf_iterator<char>(log_file)), std::istreambuf_iterator<char>());
+    const std::string followed_log_file_name = log_file_name + ".followed";
+    std::ofstream followed_log_file(followed_log_file_name, std::ios::binary | std::ios::trunc);
+
+    // Most part of log file has been recorded, then new frames are appended 1 MB by 1 MB.
+    constexpr uint64_t kSizeOfAppendedBytes = 1024 * 1024;
+    constexpr uint32_t kNumOfRefreshTimes = 20;
+    uint64_t size_of_written = log_file_bytes.size() - kSizeOfAppendedBytes * kNumOfRefreshTimes;
+    followed_log_file.write(log_file_bytes.data(), size_of_written);
+    followed_log_file.flush();
+
+    BinaryDataLog follower;
+    RETURN_IF(!follower.FollowLogFile(followed_log_file_name));
+    double refresh_time = 0.0;
+    for (uint32_t i = 0; i < kNumOfRefreshTimes; ++i) {
+        followed_log_file.write(log_file_bytes.data() + size_of_written, kSizeOfAppendedBytes);
+        followed_log_file.flush();
+        size_of_written += kSizeOfAppendedBytes;
+        refresh_time += MeasureAverageTimeInMicrosecond(1, [&](uint32_t j) { follower.RefreshFollowedLogFile(); });
+    }
+    const double reload_time = MeasureAverageTimeInMicrosecond(1, [&](uint32_t i) {
+        BinaryDataLog logger;
+        logger.LoadLogFile(followed_log_file_name);
+    });
+    ReportInfo("Refresh followed log file of " << size_of_written << " bytes after 1 MB appended : " << refresh_time / kNumOfRefreshTimes * 1e-3
+                                               << " ms, load the whole log file again : " << reload_time * 1e-3 << " ms.");
+    std::remove(followed_log_file_name.c_str());
+    std::remove((followed_log_file_name + ".idx").c_str());
+}
+
+void BenchmarkExtractItemColumns(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Benchmark extracting columns of items." RESET_COLOR);
+
+    for (const bool load_in_columns: {false, true}) {
+        BinaryDataLog logger;
+        logger.load_static_package_in_columns() = load_in_columns;
+        RETURN_IF(!logger.LoadLogFile(log_file_name));
+        const PackageInfo &package_info = *logger.packages_id_with_objects().at(1);
+        const uint32_t num_of_ticks =
+            load_in_columns ? logger.packages_id_with_columns().at(1).size() : static_cast<uint32_t>(logger.packages_id_with_data().at(1).size());
+
+        constexpr uint32_t kNumOfExtractTimes = 10;
+        for (const auto &item: package_info.items) {
+            // Convert each component of each tick.
+            const uint32_t num_of_components = item.type == ItemType::kVector3 ? 3 : 1;
+            const ItemType type = item.type == ItemType::kVector3 ? ItemType::kFloat : item.type;
+            std::vector<std::vector<float>> converted_columns(num_of_components, std::vector<float>(num_of_ticks));
+            const double convert_time = MeasureAverageTimeInMicrosecond(kNumOfExtractTimes, [&](uint32_t i) {
+                for (uint32_t j = 0; j < num_of_components; ++j) {
+                    const uint32_t index_in_package = item.bindata_index_in_package + j * sizeof(float);
+                    if (load_in_columns) {
+                        const auto &package_columns = logger.packages_id_with_columns().at(1);
+                        for (uint32_t k = 0; k < num_of_ticks; ++k) {
+                            converted_columns[j][k] = BinaryDataLog::ConvertBytes<float>(package_columns.data_of_tick(k) + index_in_package, type);
+                        }
+                    } else {
+                        const auto &package_data = logger.packages_id_with_data().at(1);
+                        for (uint32_t k = 0; k < num_of_ticks; ++k) {
+                            converted_columns[j][k] = BinaryDataLog::ConvertBytes<float>(package_data[k].data.data() + index_in_package, type);
+                        }
+                    }
+                }
+            });
+
+            std::vector<std::vector<float>> columns;
+            const double extract_time =
+                MeasureAverageTimeInMicrosecond(kNumOfExtractTimes, [&](uint32_t i) { logger.ExtractItemColumns(package_info.id, item.name, columns); });
+            ReportInfo("Extract item [" << item.name << "] of " << num_of_ticks << " ticks from " << (load_in_columns ? "columns" : "ticks")
+                                        << " : ConvertBytes " << convert_time * 1e-3 << " ms, ExtractItemColumns " << extract_time * 1e-3 << " ms.");
+            RETURN_IF(columns != converted_columns);
+        }
+    }
+}
+
+void BenchmarkQueryTicks(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Benchmark querying ticks in time range." RESET_COLOR);
+
+    for (const bool load_in_columns: {false, true}) {
+        BinaryDataLog logger;
+        logger.load_static_package_in_columns() = load_in_columns;
+        RETURN_IF(!logger.LoadLogFile(log_file_name));
+        const auto &time_range = logger.timestamp_s_range_of_loaded_log();
+
+        // Each query covers 0.1s, which is 100 ticks of imu.
+        constexpr uint32_t kNumOfQueries = 100000;
+        uint64_t num_of_queried_ticks = 0;
+        const double query_time = MeasureAverageTimeInMicrosecond(kNumOfQueries, [&](uint32_t i) {
+            const float time_stamp_s = time_range.first + (time_range.second - time_range.first) * static_cast<float>(i) / kNumOfQueries;
+            uint32_t index_of_begin_tick = 0;
+            uint32_t index_of_end_tick = 0;
+            logger.Query(1, time_stamp_s, time_stamp_s + 0.1f, index_of_begin_tick, index_of_end_tick);
+            num_of_queried_ticks += index_of_end_tick - index_of_begin_tick;
+        });
+
+        const std::vector<uint16_t> package_ids = {1, 2, 3};
+        std::vector<uint32_t> indices_of_ticks;
+        const double nearest_time = MeasureAverageTimeInMicrosecond(kNumOfQueries, [&](uint32_t i) {
+            const float time_stamp_s = time_range.first + (time_range.second - time_range.first) * static_cast<float>(i) / kNumOfQueries;
+            logger.QueryNearestTicks(package_ids, time_stamp_s, indices_of_ticks);
+        });
+        ReportInfo("Query ticks in " << (load_in_columns ? "columns" : "ticks") << " : Query " << query_time << " us (" << num_of_queried_ticks / kNumOfQueries
+                                     << " ticks), QueryNearestTicks of " << package_ids.size() << " packages " << nearest_time << " us.");
+    }
+}
+
+void BenchmarkQueryItemBuckets(const std::string &log_file_name) {
+    ReportInfo(YELLOW ">> Benchmark querying buckets of item for plotting." RESET_COLOR);
+
+    BinaryDataLog logger;
+    RETURN_IF(!logger.LoadLogFile(log_file_name));
+    const auto &time_range = logger.timestamp_s_range_of_loaded_log();
+
+    // Plot gyro in 2000 pixels, by converting all ticks in time range or by querying buckets.
+    constexpr uint32_t kNumOfPixels = 2000;
+    const auto &ticks = logger.packages_id_with_data().at(1);
+    const PackageItemInfo &item = logger.packages_id_with_objects().at(1)->items.front();
+    std::vector<float> min_values(kNumOfPixels);
+    std::vector<float> max_values(kNumOfPixels);
+    const double build_time = MeasureAverageTimeInMicrosecond(1, [&](uint32_t i) { logger.BuildItemPyramids(1, "gyro"); });
+    ReportInfo("Build pyramids of gyro with " << ticks.size() << " ticks : " << build_time * 1e-3 << " ms.");
+    for (const float zoom: {1.0f, 0.1f, 0.01f}) {
+        const float time_stamp_s_begin = time_range.first;
+        const float time_stamp_s_end = time_range.first + (time_range.second - time_range.first) * zoom;
+        const double convert_time = MeasureAverageTimeInMicrosecond(10, [&](uint32_t i) {
+            std::fill(min_values.begin(), min_values.end(), INFINITY);
+            std::fill(max_values.begin(), max_values.end(), -INFINITY);
+            uint32_t index_of_begin_tick = 0;
+            uint32_t index_of_end_tick = 0;
+            logger.Query(1, time_stamp_s_begin, time_stamp_s_end, index_of_begin_tick, index_of_end_tick);
+            for (uint32_t j = index_of_begin_tick; j < index_of_end_tick; ++j) {
+                const uint32_t pixel = std::min<uint32_t>(
+                    kNumOfPixels - 1, (ticks[j].timestamp_s - time_stamp_s_begin) / (time_stamp_s_end - time_stamp_s_begin) * kNumOfPixels);
+                for (uint32_t k = 0; k < 3; ++k) {
+                    const float value = BinaryDataLog::ConvertBytes<float>(ticks[j].data.data() + item.bindata_index_in_package + k * 4, ItemType::kFloat);
+                    min_values[pixel] = std::min(min_values[pixel], value);
+                    max_values[pixel] = std::max(max_values[pixel], value);
+                }
+            }
+        });
+
+        std::vector<std::vector<TimeSeriesBucket>> buckets_of_components;
+        const double query_time = MeasureAverageTimeInMicrosecond(100, [&](uint32_t i) {
+            logger.QueryItemBuckets(1, "gyro", time_stamp_s_begin, time_stamp_s_end, kNumOfPixels, buckets_of_components);
+        });
+        ReportInfo("Plot " << zoom * 100.0f << "% of gyro in " << kNumOfPixels << " pixels : ConvertBytes " << convert_time * 1e-3
+                           << " ms, QueryItemBuckets " << query_time * 1e-3 << " ms (" << buckets_of_components.front().size()
+                           << " buckets).");
+    }
+}
+
+void BenchmarkDecodeColumns() {
+    ReportInfo(YELLOW ">> Benchmark decoding columns in batch." RESET_COLOR);
+
+    constexpr uint32_t kNumOfQuaternions = 1000000;
+    std::vector<std::vector<float>> components(4, std::vector<float>(kNumOfQuaternions));
+    for (uint32_t i = 0; i < kNumOfQuaternions; ++i) {
+        const float half_angle = static_cast<float>(i) * 1e-5f;
+        components[0][i] = std::cos(half_angle);
+        components[1][i] = std::sin(half_angle) * 0.6f;
+        components[2][i] = -std::sin(half_angle) * 0.48f;
+        components[3][i] = std::sin(half_angle) * 0.64f;
+    }
+
+    constexpr uint32_t kNumOfDecodeTimes = 10;
+    for (const DecodeType decoder: {DecodeType::kQuaternionToRoll, DecodeType::kQuaternionToPitch, DecodeType::kQuaternionToYaw, DecodeType::kVector3dToMod}) {
+        // Decode each quaternion by scalar path.
+        std::vector<float> scalar_values(kNumOfQuaternions);
+        const double scalar_time = MeasureAverageTimeInMicrosecond(kNumOfDecodeTimes, [&](uint32_t i) {
+            for (uint32_t j = 0; j < kNumOfQuaternions; ++j) {
+                const float quaternion[4] = {components[0][j], components[1][j], components[2][j], components[3][j]};
+                scalar_values[j] = BinaryDataLog::ConvertBytes<float>(reinterpret_cast<const uint8_t *>(quaternion), ItemType::kFloat, decoder);
+            }
+        });
+
+        std::vector<float> values;
+        const double batch_time =
+            MeasureAverageTimeInMicrosecond(kNumOfDecodeTimes, [&](uint32_t i) { BinaryDataLog::DecodeColumns(components, decoder, values); });
+        float max_error = 0.0f;
+        for (uint32_t j = 0; j < kNumOfQuaternions; ++j) {
+            max_error = std::max(max_error, std::fabs(values[j] - scalar_values[j]));
+        }
+        ReportInfo("Decode " << kNumOfQuaternions << " samples by decoder " << static_cast<int32_t>(decoder) << " : ConvertBytes " << scalar_time * 1e-3
+                             << " ms, DecodeColumns " << batch_time * 1e-3 << " ms, max error " << max_error << ".");
+    }
+}
+
+void BenchmarkCreateLogFileByCsvFile(const std::string &log_file_name, const std::string &example_csv_file_name) {
+    ReportInfo(YELLOW ">> Benchmark creating log file by csv file." RESET_COLOR);
+
+    // Example csv file is scaled up by repeating its lines, and timestamps in nanoseconds keep increasing.
+    std::ifstream example_csv_file(example_csv_file_name);
+    std::string csv_header;
+    std::string csv_line;
+    std::vector<std::pair<uint64_t, std::string>> csv_lines;
+    RETURN_IF(!std::getline(example_csv_file, csv_header));
+    while (std::getline(example_csv_file, csv_line) && !csv_line.empty()) {
+        const uint64_t time_stamp_ns = std::stoull(csv_line.substr(0, csv_line.find(',')));
+        csv_lines.emplace_back(time_stamp_ns, csv_line.substr(csv_line.find(',')));
+    }
+    RETURN_IF(csv_lines.size() < 2);
+    const uint64_t duration_ns = csv_lines.back().first - csv_lines.front().first + (csv_lines[1].first - csv_lines[0].first);
+    const uint32_t times_of_repeat = 30;
+    const std::string csv_file_name = log_file_name + ".csv";
+    {
+        std::ofstream csv_file(csv_file_name, std::ios::trunc);
+        csv_file << csv_header << "\n";
+        for (uint32_t i = 0; i < times_of_repeat; ++i) {
+            for (const auto &[time_stamp_ns, values]: csv_lines) {
+                csv_file << time_stamp_ns + i * duration_ns << values << "\n";
+            }
+        }
+    }
+    std::ifstream scaled_csv_file(csv_file_name, std::ios::binary | std::ios::ate);
+    const double size_of_csv_file_mb = static_cast<double>(scaled_csv_file.tellg()) / 1024.0 / 1024.0;
+
+    const std::string csv_log_file_name = log_file_name + ".csv.binlog";
+    const uint64_t num_of_lines = csv_lines.size() * times_of_repeat;
+    for (const uint32_t num_of_threads: {1u, 2u, 4u, 8u}) {
+        const double create_time = MeasureAverageTimeInMicrosecond(
+            3, [&](uint32_t i) { BinaryDataLog::CreateLogFileByCsvFile(csv_file_name, csv_log_file_name, num_of_threads); });
+        ReportInfo("Create log file by csv file of " << num_of_lines << " lines, " << size_of_csv_file_mb << " MB, " << num_of_threads << " threads : "
+                                                     << create_time * 1e-3 << " ms, " << size_of_csv_file_mb / create_time * 1e6 << " MB/s, "
+                                                     << create_time * 1e3 / num_of_lines << " ns per line.");
+    }
+    const double stream_time = MeasureAverageTimeInMicrosecond(3, [&](uint32_t i) {
+        std::ifstream csv_stream(csv_file_name, std::ios::binary);
+        BinaryDataLog::CreateLogFileByCsvStream(csv_stream, csv_log_file_name);
+    });
+    ReportInfo("Create log file by csv stream of " << num_of_lines << " lines, " << size_of_csv_file_mb << " MB : " << stream_time * 1e-3 << " ms, "
+                                                   << size_of_csv_file_mb / stream_time * 1e6 << " MB/s.");
+    const double merge_time =
+        MeasureAverageTimeInMicrosecond(3, [&](uint32_t i) { BinaryDataLog::CreateLogFileByCsvFiles({csv_file_name, csv_file_name}, csv_log_file_name); });
+    ReportInfo("Merge 2 csv files of " << num_of_lines << " lines, " << size_of_csv_file_mb << " MB each : " << merge_time * 1e-3 << " ms, "
+                                       << size_of_csv_file_mb * 2 / merge_time * 1e6 << " MB/s.");
+    std::remove(csv_file_name.c_str());
+    std::remove(csv_log_file_name.c_str());
+}
+
+int main(int argc, char **argv) {
+    ReportInfo(YELLOW ">> Benchmark binary data log." RESET_COLOR);
+    const std::string log_file_name = argc > 1 ? argv[1] : "benchmark.binlog";
+
+    BenchmarkRecordPackages(log_file_name, FrameCheckType::kSummaryByte);
+    BenchmarkLoadLogFile(log_file_name);
+    BenchmarkSidecarIndex(log_file_name);
+    BenchmarkLoadBinaryDataViewsInParallel(log_file_name);
+    BenchmarkPrefetchPayloads(log_file_name);
+    BenchmarkReplayLogFile(log_file_name);
+    BenchmarkFollowLogFile(log_file_name);
+    BenchmarkExtractItemColumns(log_file_name);
+    BenchmarkQueryTicks(log_file_name);
+    BenchmarkQueryItemBuckets(log_file_name);
+    BenchmarkDecodeColumns();
+    BenchmarkRecordPackages(log_file_name, FrameCheckType::kCrc32c);
+    BenchmarkCreateLogFileByCsvFile(log_file_name, "../example/imu_data.csv");
+
+    return 0;
+}
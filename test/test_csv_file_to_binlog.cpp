@@ -16,12 +16,31 @@ using namespace slam_visualizor;
 
 int main(int argc, char **argv) {
     ReportColorWarn(">> Test csv file to binlog.");
+    // Csv is read from stdin if csv file is '-'. All csv files in it are merged if csv file is a directory.
     const std::string csv_file = argv[1];
-    const std::string binlog_file = argc > 2 ? argv[2] : csv_file.substr(0, csv_file.find_last_of('.')) + ".binlog";
+    const bool is_stdin = csv_file == "-";
+    const bool is_directory = std::filesystem::is_directory(csv_file);
+    const std::string binlog_file = argc > 2 ? argv[2] :
+                                    (is_stdin || is_directory ? "data.binlog" : csv_file.substr(0, csv_file.find_last_of('.')) + ".binlog");
     ReportInfo("[input] CSV file: " << csv_file);
+    const uint32_t num_of_threads = argc > 3 ? static_cast<uint32_t>(std::stoul(argv[3])) : 1;
     ReportInfo("[output] Binlog file: " << binlog_file);
+    ReportInfo("[threads] Number of threads: " << num_of_threads);
 
-    BinaryDataLog::CreateLogFileByCsvFile(csv_file, binlog_file);
+    if (is_stdin) {
+        BinaryDataLog::CreateLogFileByCsvFileDescriptor(STDIN_FILENO, binlog_file);
+    } else if (is_directory) {
+        std::vector<std::string> csv_files;
+        for (const auto &entry: std::filesystem::directory_iterator(csv_file)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".csv") {
+                csv_files.emplace_back(entry.path().string());
+            }
+        }
+        std::sort(csv_files.begin(), csv_files.end());
+        BinaryDataLog::CreateLogFileByCsvFiles(csv_files, binlog_file);
+    } else {
+        BinaryDataLog::CreateLogFileByCsvFile(csv_file, binlog_file, num_of_threads);
+    }
 
     return 0;
 }